@@ -0,0 +1,794 @@
+////////////////////////////////////////////////////////////
+// Headless benchmark of the gui library
+//
+// Builds parametric scenes, renders them offscreen and writes timings as JSON.
+//
+// Build (Windows) : the Benchmark project of the solution, bench/Benchmark.vcxproj,
+// runs from the repository root
+//
+// Build (Linux, SFML 2.5 from the package manager) :
+//	g++ -std=c++17 -O2 -Isrc bench/benchmark.cpp src/GUI/*.cpp $(pkg-config --cflags --libs sfml-graphics) -o gui_bench
+//
+// Run from the repository root so data/consola.ttf is found :
+//	./gui_bench [--buttons N] [--depth D] [--items M] [--chars K]
+//				[--iterations I] [--font path] [--out file.json] [--sweep]
+//
+// Scenes are drawn on a sf::RenderTexture, which still needs an OpenGL
+// context : run under X, or under xvfb-run on machines without display.
+//
+// Every measure reports microseconds per operation. Operations cheaper than
+// a clock tick (hit tests, name lookups) are timed in batches and divided.
+//
+// Exits with 3 if a rendering budget or the page traversal check fails,
+// results are still written.
+////////////////////////////////////////////////////////////
+
+#include "GUI.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+////////////////////////////////////////////////////////////
+// timing
+////////////////////////////////////////////////////////////
+
+typedef std::chrono::steady_clock Clock;
+
+// results of timed lookups are stored here so they are not optimised away
+volatile unsigned long long lookupSink = 0;
+
+double elapsedMicroseconds(Clock::time_point start)
+{
+	return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+struct Measure {
+	std::string name;
+	std::vector<double> samples;	// microseconds per operation
+
+	Measure(const std::string& name) : name(name) {}
+
+	double percentile(double p) const
+	{
+		if (samples.empty())return 0;
+
+		std::vector<double> sorted = samples;
+		std::sort(sorted.begin(), sorted.end());
+		return sorted[std::min(sorted.size() - 1, (std::size_t)(p * (sorted.size() - 1) + 0.5))];
+	}
+
+	double mean() const
+	{
+		double sum = 0;
+		for (double sample : samples)sum += sample;
+		return samples.empty() ? 0 : sum / samples.size();
+	}
+};
+
+////////////////////////////////////////////////////////////
+// scene
+////////////////////////////////////////////////////////////
+
+struct Parameters {
+	int buttons = 100;		// buttons inside the innermost page
+	int depth = 3;			// number of nested pages
+	int items = 50;			// items of the dropdown
+	int chars = 200;		// characters of the textbox
+	int iterations = 300;	// samples per measure
+};
+
+const sf::Vector2u targetSize(1280, 720);
+
+struct Scene {
+	sf::RenderTexture target;
+	gui::ScriptedInput input;
+	gui::Frame frame;
+
+	std::deque<gui::Page> pages;			// pages[0] is attached to the frame
+	std::deque<gui::Button> buttons;
+	std::deque<gui::TextButton> items;
+	std::deque<gui::TextButton> spareItems;	// inserted and erased by the dropdown measure
+	std::unique_ptr<gui::Dropdown> dropdown;
+	gui::Textbox textbox;
+	std::vector<std::string> names;
+
+	bool create(const Parameters& parameters, sf::Font& font);
+};
+
+// every item shares one style
+const std::shared_ptr<const gui::Style>& itemStyle()
+{
+	static std::shared_ptr<const gui::Style> style;
+	if (!style) {
+		gui::Style::Look normal, selection;
+		normal.fillColor = sf::Color::Transparent;
+		normal.outlineColor = sf::Color(160, 32, 240);
+		normal.outlineThickness = 3;
+		selection.fillColor = sf::Color(160, 32, 240, 126);
+		style = std::make_shared<const gui::Style>(normal, selection);
+	}
+	return style;
+}
+
+void styleItem(gui::TextButton& item, const sf::Font& font, const std::string& string)
+{
+	item.setButtonStyle(itemStyle());
+	item.setCharacterSize(22);
+	item.setTextFillColor(sf::Color::White);
+	item.setFont(font);
+	item.setString(string);
+}
+
+bool Scene::create(const Parameters& parameters, sf::Font& font)
+{
+	if (!target.create(targetSize.x, targetSize.y))return false;
+
+	frame.setRenderTarget(target);
+	frame.setInputSource(input);
+
+	// nested pages, rotated and scaled like the demo
+	for (int i = 0; i < parameters.depth; i++) {
+		pages.emplace_back();
+		gui::Page& page = pages.back();
+
+		float size = 900.f - 60.f * i;
+		page.setFillColor(sf::Color(255, 255, 255, 26));
+		page.setMaxSize({ size * 2, size * 2 });
+		page.setActiveRegion({ 0, 0, size, size * 0.6f });
+		page.setScroll(gui::Page::RIGHT);
+		page.setScroll(gui::Page::BOTTOM);
+		page.setHeader(true, true, true);
+		page.setPosition(40, 40);
+		page.rotate(i % 2 ? -10.f : 10.f);
+		page.scale(0.95f, 0.95f);
+
+		if (i == 0)frame.addEntity(page);
+		else pages[i - 1].addEntity(page);
+	}
+
+	// buttons laid out in a grid in the innermost page
+	int columns = std::max(1, (int)std::ceil(std::sqrt((float)parameters.buttons)));
+	for (int i = 0; i < parameters.buttons; i++) {
+		buttons.emplace_back();
+		gui::Button& button = buttons.back();
+
+		button.setPointCount(4);
+		button.setPoint(0, { 0, 0 });
+		button.setPoint(1, { 30, 0 });
+		button.setPoint(2, { 30, 20 });
+		button.setPoint(3, { 0, 20 });
+		button.setPosition(10.f + 40.f * (i % columns), 10.f + 30.f * (i / columns));
+		button.setFillColor(sf::Color::Red);
+		button.setSelectionFillColor(sf::Color::Blue);
+
+		if (pages.empty())frame.addEntity(button);
+		else pages.back().addEntity(button);
+	}
+
+	// dropdown attached to the frame
+	dropdown.reset(new gui::Dropdown({ 300, 40 }, 40, 5));
+	dropdown->setPosition(900, 20);
+	dropdown->setFillColor(sf::Color(255, 255, 255, 26));
+	dropdown->setTitle("Drop", font, 24, sf::Color::White);
+	for (int i = 0; i < parameters.items; i++) {
+		items.emplace_back();
+		styleItem(items.back(), font, "item " + std::to_string(i));
+		dropdown->addItem(items.back());
+	}
+	frame.addEntity(*dropdown);
+
+	// textbox attached to the frame
+	textbox.setSize({ 400, 200 });
+	textbox.setPosition(860, 450);
+	textbox.setBoxFillColor(sf::Color::Transparent);
+	textbox.setBoxOutlineColor(sf::Color(160, 32, 240));
+	textbox.setBoxOutlineThickness(3);
+	textbox.setCharacterSize(16);
+	textbox.setTextFillColor(sf::Color::White);
+	textbox.setFont(font);
+	std::string string;
+	for (int i = 0; i < parameters.chars; i++)string += (char)('a' + i % 26);
+	textbox.setString(string);
+	frame.addEntity(textbox);
+
+	// every button and item is named
+	for (std::size_t i = 0; i < buttons.size(); i++) {
+		names.push_back("button_" + std::to_string(i));
+		frame.setName(buttons[i], names.back());
+	}
+	for (std::size_t i = 0; i < items.size(); i++) {
+		names.push_back("item_" + std::to_string(i));
+		frame.setName(items[i], names.back());
+	}
+
+	return true;
+}
+
+// mouse position of the n-th sample, sweeping the whole target
+sf::Vector2i samplePosition(int n)
+{
+	return sf::Vector2i((n * 37) % targetSize.x, (n * 23) % targetSize.y);
+}
+
+////////////////////////////////////////////////////////////
+// measures
+////////////////////////////////////////////////////////////
+
+void measureUpdate(Scene& scene, const Parameters& parameters, std::vector<Measure>& measures)
+{
+	Measure measure = { "frame_update" };
+	for (int i = 0; i < parameters.iterations; i++) {
+		sf::Vector2i position = samplePosition(i);
+		scene.input.moveMouse(position.x, position.y);
+		scene.input.advanceTime(sf::milliseconds(16));
+		scene.frame.pollInputEvents();
+
+		auto start = Clock::now();
+		scene.frame.update();
+		measure.samples.push_back(elapsedMicroseconds(start));
+	}
+	measures.push_back(measure);
+}
+
+void measurePollEvents(Scene& scene, const Parameters& parameters, std::vector<Measure>& measures)
+{
+	Measure measure = { "frame_poll_events" };
+	for (int i = 0; i < parameters.iterations; i++) {
+		sf::Vector2i position = samplePosition(i);
+
+		// cycle through the events handled by the frame
+		sf::Event event;
+		switch (i % 4) {
+		case 0:
+			event.type = sf::Event::MouseMoved;
+			event.mouseMove.x = position.x;
+			event.mouseMove.y = position.y;
+			break;
+		case 1:
+			event.type = sf::Event::MouseButtonPressed;
+			event.mouseButton.button = sf::Mouse::Left;
+			event.mouseButton.x = position.x;
+			event.mouseButton.y = position.y;
+			break;
+		case 2:
+			event.type = sf::Event::MouseButtonReleased;
+			event.mouseButton.button = sf::Mouse::Left;
+			event.mouseButton.x = position.x;
+			event.mouseButton.y = position.y;
+			break;
+		default:
+			event.type = sf::Event::MouseWheelScrolled;
+			event.mouseWheelScroll.wheel = sf::Mouse::VerticalWheel;
+			event.mouseWheelScroll.delta = i % 8 < 4 ? -1.f : 1.f;
+			event.mouseWheelScroll.x = position.x;
+			event.mouseWheelScroll.y = position.y;
+			break;
+		}
+
+		auto start = Clock::now();
+		scene.frame.pollEvents(event);
+		measure.samples.push_back(elapsedMicroseconds(start));
+	}
+	measures.push_back(measure);
+}
+
+void measureDraw(Scene& scene, const Parameters& parameters, std::vector<Measure>& measures)
+{
+	// nothing changed, only the backbuffer is copied
+	Measure idle = { "frame_draw_idle" };
+	scene.frame.draw();
+	for (int i = 0; i < parameters.iterations; i++) {
+		auto start = Clock::now();
+		scene.frame.draw();
+		scene.target.display();
+		idle.samples.push_back(elapsedMicroseconds(start));
+	}
+	measures.push_back(idle);
+
+	// every top level entity redrawn
+	Measure full = { "frame_draw_full" };
+	std::vector<const gui::Entity*> roots;
+	if (!scene.pages.empty())roots.push_back(&scene.pages.front());
+	else for (auto& button : scene.buttons)roots.push_back(&button);
+	roots.push_back(scene.dropdown.get());
+	roots.push_back(&scene.textbox);
+
+	for (int i = 0; i < parameters.iterations; i++) {
+		for (auto root : roots)scene.frame.requestRedraw(*root);
+
+		auto start = Clock::now();
+		scene.frame.draw();
+		scene.target.display();
+		full.samples.push_back(elapsedMicroseconds(start));
+	}
+	measures.push_back(full);
+}
+
+void measureHit(Scene& scene, const Parameters& parameters, std::vector<Measure>& measures)
+{
+	if (scene.pages.empty())return;
+
+	const int batch = 1000;
+	Measure measure = { "page_is_hit" };
+	for (int i = 0; i < parameters.iterations; i++) {
+		auto start = Clock::now();
+		for (int j = 0; j < batch; j++)
+			scene.pages.front().isHit(sf::Vector2f(samplePosition(i * batch + j)));
+		measure.samples.push_back(elapsedMicroseconds(start) / batch);
+	}
+	measures.push_back(measure);
+}
+
+void measureDropdown(Scene& scene, const Parameters& parameters, const sf::Font& font, std::vector<Measure>& measures)
+{
+	Measure insert = { "dropdown_insert_item" };
+	Measure erase = { "dropdown_erase_item" };
+
+	scene.spareItems.emplace_back();
+	gui::TextButton& item = scene.spareItems.back();
+	styleItem(item, font, "spare");
+
+	for (int i = 0; i < parameters.iterations; i++) {
+		int where = parameters.items / 2;
+
+		auto start = Clock::now();
+		scene.dropdown->insertItem(where, item);
+		insert.samples.push_back(elapsedMicroseconds(start));
+
+		start = Clock::now();
+		scene.dropdown->eraseItem(where);
+		erase.samples.push_back(elapsedMicroseconds(start));
+	}
+	measures.push_back(insert);
+	measures.push_back(erase);
+}
+
+// geometry of every state is built on its first draw, later switches only pick it
+void measureStates(Scene& scene, const Parameters& parameters, std::vector<Measure>& measures)
+{
+	if (scene.items.empty())return;
+
+	Measure measure = { "item_hover_toggle" };
+	gui::TextButton& item = scene.items.front();
+	for (int i = 0; i < parameters.iterations; i++) {
+		auto start = Clock::now();
+		item.activateSelection();
+		scene.frame.draw();
+		item.deactivateSelection();
+		scene.frame.draw();
+		measure.samples.push_back(elapsedMicroseconds(start) / 2);
+	}
+	measures.push_back(measure);
+}
+
+// one update eases every button, the time is driven by hand so no frame is skipped
+void measureAnimation(Scene& scene, const Parameters& parameters, std::vector<Measure>& measures)
+{
+	if (scene.buttons.empty())return;
+
+	Measure measure = { "animator_update" };
+	gui::Animator& animator = scene.frame.getAnimator();
+	sf::Time time = sf::Time::Zero;
+	animator.update(time);
+
+	for (int i = 0; i < parameters.iterations; i++) {
+		// restart every animation each second update, so both adding and easing are timed
+		if (i % 2 == 0) {
+			for (auto& button : scene.buttons)
+				animator.animatePosition(button, button.getPosition() + sf::Vector2f(i % 4 == 0 ? 1.f : -1.f, 0), sf::seconds(1));
+		}
+		time += sf::milliseconds(16);
+
+		auto start = Clock::now();
+		animator.update(time);
+		measure.samples.push_back(elapsedMicroseconds(start) / scene.buttons.size());
+	}
+	for (auto& button : scene.buttons)animator.stop(button);
+	measures.push_back(measure);
+}
+
+// header, scrolls and rows of the model are created on first use,
+// a plain page or dropdown only builds what it always needs
+void measureConstruction(const Parameters& parameters, std::vector<Measure>& measures)
+{
+	const int batch = 100;
+	Measure page = { "page_construct" };
+	Measure dropdown = { "dropdown_construct" };
+
+	for (int i = 0; i < parameters.iterations; i++) {
+		auto start = Clock::now();
+		for (int j = 0; j < batch; j++) {
+			gui::Page constructed({ 400, 300 });
+		}
+		page.samples.push_back(elapsedMicroseconds(start) / batch);
+
+		start = Clock::now();
+		for (int j = 0; j < batch; j++) {
+			gui::Dropdown constructed({ 300, 40 }, 40, 5);
+		}
+		dropdown.samples.push_back(elapsedMicroseconds(start) / batch);
+	}
+	measures.push_back(page);
+	measures.push_back(dropdown);
+}
+
+// a batch of items fits the page and its scroll once, loading is linear in the batch
+void measureBatch(Scene& scene, const Parameters& parameters, const sf::Font& font, std::vector<Measure>& measures)
+{
+	const int itemCount = 10000;
+	const int batches = std::min(parameters.iterations, 20);
+	Measure add = { "dropdown_add_items" };
+	Measure erase = { "dropdown_erase_items" };
+
+	std::deque<gui::TextButton> items(itemCount);
+	std::vector<gui::Textbox*> batch;
+	for (auto& item : items) {
+		styleItem(item, font, "batch");
+		batch.push_back(&item);
+	}
+
+	gui::Dropdown dropdown({ 300, 40 }, 40, 5);
+	dropdown.setPosition(20, 20);
+	scene.frame.addEntity(dropdown);
+
+	for (int i = 0; i < batches; i++) {
+		auto start = Clock::now();
+		dropdown.addItems(batch);
+		add.samples.push_back(elapsedMicroseconds(start));
+
+		start = Clock::now();
+		dropdown.eraseItems(0, itemCount);
+		erase.samples.push_back(elapsedMicroseconds(start));
+	}
+
+	scene.frame.removeEntity(dropdown);
+	measures.push_back(add);
+	measures.push_back(erase);
+}
+
+// a dropdown driven by a data source only materialises its visible rows,
+// scrolling costs the same whatever the number of items
+void measureModel(Scene& scene, const Parameters& parameters, const sf::Font& font, std::vector<Measure>& measures)
+{
+	const std::size_t itemCount = 50000;
+	Measure scroll = { "dropdown_model_scroll" };
+
+	gui::TextButton style;
+	styleItem(style, font, "");
+
+	gui::Dropdown dropdown({ 300, 40 }, 40, 5);
+	dropdown.setPosition(20, 20);
+	dropdown.setModel([itemCount] { return itemCount; }, [](std::size_t i) { return "symbol_" + std::to_string(i); }, style);
+	scene.frame.addEntity(dropdown);
+
+	sf::Event event;
+	event.type = sf::Event::MouseWheelScrolled;
+	event.mouseWheelScroll.wheel = sf::Mouse::VerticalWheel;
+	event.mouseWheelScroll.x = 20;
+	event.mouseWheelScroll.y = 20;
+
+	for (int i = 0; i < parameters.iterations; i++) {
+		// scroll down for a while, then back up
+		event.mouseWheelScroll.delta = (i / 100) % 2 == 0 ? -4.f : 4.f;
+
+		auto start = Clock::now();
+		dropdown.pollEvents(event);
+		scroll.samples.push_back(elapsedMicroseconds(start));
+	}
+
+	scene.frame.removeEntity(dropdown);
+	measures.push_back(scroll);
+}
+
+void measureNames(Scene& scene, const Parameters& parameters, std::vector<Measure>& measures)
+{
+	if (scene.names.empty())return;
+
+	const int batch = 1000;
+	Measure byName = { "name_get_id" };
+	Measure byHashedName = { "name_get_id_hashed" };
+	Measure byID = { "name_get_name" };
+	unsigned long long checksum = 0;
+
+	// names hashed once, as a constexpr gui::Name would be
+	std::vector<gui::Name> hashed(scene.names.begin(), scene.names.end());
+
+	for (int i = 0; i < parameters.iterations; i++) {
+		auto start = Clock::now();
+		for (int j = 0; j < batch; j++)
+			checksum += scene.frame.getIDByName(scene.names[(i * batch + j) % scene.names.size()]);
+		byName.samples.push_back(elapsedMicroseconds(start) / batch);
+
+		start = Clock::now();
+		for (int j = 0; j < batch; j++)
+			checksum += scene.frame.getIDByName(hashed[(i * batch + j) % hashed.size()]);
+		byHashedName.samples.push_back(elapsedMicroseconds(start) / batch);
+
+		start = Clock::now();
+		for (int j = 0; j < batch; j++)
+			checksum += (unsigned int)scene.frame.getName(scene.buttons.empty() ? scene.items[j % scene.items.size()].getID() : scene.buttons[j % scene.buttons.size()].getID()).size();
+		byID.samples.push_back(elapsedMicroseconds(start) / batch);
+	}
+
+	lookupSink = checksum;
+
+	measures.push_back(byName);
+	measures.push_back(byHashedName);
+	measures.push_back(byID);
+}
+
+// scrolling a page used to move every child back and forth during draw,
+// a draw must leave the children untouched and nothing to redraw
+struct TraversalCheck {
+	int movedChildren = 0;
+	int transformChanges = 0;
+	int probeDraws = 0;
+	bool pendingAfterDraw = false;
+	unsigned int steadyDamagedPixels = 0;
+	bool passed = true;
+};
+
+// button counting the draws and bounds queries seeing another transform than
+// the settled one, moving it and back around the draw leaves its position intact
+class ProbeButton : public gui::Button {
+public:
+	mutable int draws = 0;
+	mutable int transformChanges = 0;
+
+	void settle()
+	{
+		m_settled = getTransform();
+	}
+	sf::FloatRect getDrawBounds() const override
+	{
+		if (getTransform() != m_settled)transformChanges++;
+		return gui::Button::getDrawBounds();
+	}
+	void submit(gui::RenderBatch& batch, sf::RenderStates states) const override
+	{
+		draws++;
+		if (getTransform() != m_settled)transformChanges++;
+		gui::Button::submit(batch, states);
+	}
+
+private:
+	sf::Transform m_settled;
+};
+
+TraversalCheck checkTraversal(Scene& scene)
+{
+	TraversalCheck check;
+	if (scene.pages.empty())return check;
+
+	gui::Page& page = scene.pages.back();
+	sf::FloatRect region = page.getActiveRegion();
+
+	// probe stays inside the active region once it is scrolled
+	ProbeButton probe;
+	probe.setPointCount(4);
+	probe.setPoint(0, { 0, 0 });
+	probe.setPoint(1, { 10, 0 });
+	probe.setPoint(2, { 10, 10 });
+	probe.setPoint(3, { 0, 10 });
+	probe.setPosition(region.left + 20, region.top + 20);
+	page.addEntity(probe);
+	probe.settle();
+
+	page.setActiveRegion({ region.left + 15, region.top + 15, region.width, region.height });
+
+	std::vector<sf::Vector2f> positions;
+	for (auto& button : scene.buttons)positions.push_back(button.getPosition());
+
+	scene.frame.draw();
+	for (std::size_t i = 0; i < positions.size(); i++) {
+		if (scene.buttons[i].getPosition() != positions[i])check.movedChildren++;
+	}
+
+	check.pendingAfterDraw = scene.frame.hasPendingRedraw();
+	scene.frame.draw();
+	check.steadyDamagedPixels = scene.frame.getDamagedPixelCount();
+
+	check.transformChanges = probe.transformChanges;
+	check.probeDraws = probe.draws;
+	check.passed = check.movedChildren == 0 && check.transformChanges == 0 && check.probeDraws > 0 &&
+		!check.pendingAfterDraw && check.steadyDamagedPixels == 0;
+
+	page.removeEntity(probe);
+	page.setActiveRegion(region);
+	return check;
+}
+
+// a page whose content has not changed is drawn again with the frame,
+// it must only draw its retained surface and chrome : children draw in
+// their own scope, so none of them may have recorded any geometry
+struct BudgetCheck {
+	gui::RenderBatch::Stats page = gui::RenderBatch::Stats();
+	int redrawnChildren = 0;
+	bool passed = true;
+};
+
+const unsigned int staticPageDrawCalls = 2;
+
+BudgetCheck checkBudgets(Scene& scene)
+{
+	BudgetCheck check;
+	if (scene.pages.empty())return check;
+
+	gui::Page& page = scene.pages.front();
+	scene.frame.draw();
+	scene.frame.requestRedraw(page);
+	scene.frame.draw();
+
+	check.page = scene.frame.getRenderStats(page.getID());
+
+	// nested pages and the buttons of the innermost one are all inside the cached page
+	std::vector<const gui::Entity*> children;
+	for (std::size_t i = 1; i < scene.pages.size(); i++)children.push_back(&scene.pages[i]);
+	for (auto& button : scene.buttons)children.push_back(&button);
+	for (const gui::Entity* child : children) {
+		gui::RenderBatch::Stats stats = scene.frame.getRenderStats(child->getID());
+		if (stats.drawCalls != 0 || stats.vertices != 0 || stats.surfacesCreated != 0)check.redrawnChildren++;
+	}
+
+	check.passed = check.page.drawCalls <= staticPageDrawCalls && check.page.surfacesCreated == 0 && check.redrawnChildren == 0;
+	return check;
+}
+
+////////////////////////////////////////////////////////////
+// output
+////////////////////////////////////////////////////////////
+
+struct SceneResult {
+	Parameters parameters;
+	std::vector<Measure> measures;
+	TraversalCheck traversal;
+	BudgetCheck budgets;
+	gui::RenderBatch::Stats fullDraw = gui::RenderBatch::Stats();
+};
+
+void writeJson(std::ostream& out, const std::vector<SceneResult>& results)
+{
+	out << "{\n  \"sizes\": { \"page\": " << sizeof(gui::Page) << ", \"dropdown\": " << sizeof(gui::Dropdown)
+		<< ", \"button\": " << sizeof(gui::Button) << ", \"text_button\": " << sizeof(gui::TextButton) << " },\n";
+	out << "  \"scenes\": [\n";
+	for (std::size_t i = 0; i < results.size(); i++) {
+		const SceneResult& result = results[i];
+		const Parameters& p = result.parameters;
+
+		out << "    {\n";
+		out << "      \"parameters\": { \"buttons\": " << p.buttons << ", \"depth\": " << p.depth
+			<< ", \"items\": " << p.items << ", \"chars\": " << p.chars << ", \"iterations\": " << p.iterations << " },\n";
+		out << "      \"full_draw\": { \"draw_calls\": " << result.fullDraw.drawCalls << ", \"vertices\": " << result.fullDraw.vertices
+			<< ", \"texture_switches\": " << result.fullDraw.textureSwitches << ", \"surfaces_created\": " << result.fullDraw.surfacesCreated << " },\n";
+		out << "      \"static_page_budget\": { \"draw_calls\": " << result.budgets.page.drawCalls << ", \"max_draw_calls\": " << staticPageDrawCalls
+			<< ", \"surfaces_created\": " << result.budgets.page.surfacesCreated << ", \"redrawn_children\": " << result.budgets.redrawnChildren << ", \"passed\": " << (result.budgets.passed ? "true" : "false") << " },\n";
+		out << "      \"page_traversal\": { \"moved_children\": " << result.traversal.movedChildren
+			<< ", \"transform_changes\": " << result.traversal.transformChanges << ", \"probe_draws\": " << result.traversal.probeDraws
+			<< ", \"pending_redraw_after_draw\": " << (result.traversal.pendingAfterDraw ? "true" : "false")
+			<< ", \"steady_damaged_pixels\": " << result.traversal.steadyDamagedPixels
+			<< ", \"passed\": " << (result.traversal.passed ? "true" : "false") << " },\n";
+		out << "      \"measures\": {\n";
+		for (std::size_t j = 0; j < result.measures.size(); j++) {
+			const Measure& m = result.measures[j];
+			out << "        \"" << m.name << "\": { \"samples\": " << m.samples.size()
+				<< ", \"mean_us\": " << m.mean() << ", \"p50_us\": " << m.percentile(0.5)
+				<< ", \"p99_us\": " << m.percentile(0.99) << ", \"min_us\": " << m.percentile(0)
+				<< ", \"max_us\": " << m.percentile(1) << " }" << (j + 1 < result.measures.size() ? "," : "") << "\n";
+		}
+		out << "      }\n";
+		out << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	out << "  ]\n}\n";
+}
+
+bool runScene(const Parameters& parameters, sf::Font& font, SceneResult& result)
+{
+	Scene scene;
+	if (!scene.create(parameters, font))return false;
+
+	result.parameters = parameters;
+	result.traversal = checkTraversal(scene);
+
+	measureUpdate(scene, parameters, result.measures);
+	measurePollEvents(scene, parameters, result.measures);
+	measureDraw(scene, parameters, result.measures);
+	result.fullDraw = scene.frame.getRenderStats();
+	result.budgets = checkBudgets(scene);
+	measureHit(scene, parameters, result.measures);
+	measureDropdown(scene, parameters, font, result.measures);
+	measureStates(scene, parameters, result.measures);
+	measureAnimation(scene, parameters, result.measures);
+	measureBatch(scene, parameters, font, result.measures);
+	measureConstruction(parameters, result.measures);
+	measureModel(scene, parameters, font, result.measures);
+	measureNames(scene, parameters, result.measures);
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	Parameters parameters;
+	std::string fontPath = "data/consola.ttf";
+	std::string outPath;
+	bool sweep = false;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--sweep")sweep = true;
+		else if (arg == "--buttons" && hasValue)parameters.buttons = std::atoi(argv[++i]);
+		else if (arg == "--depth" && hasValue)parameters.depth = std::atoi(argv[++i]);
+		else if (arg == "--items" && hasValue)parameters.items = std::atoi(argv[++i]);
+		else if (arg == "--chars" && hasValue)parameters.chars = std::atoi(argv[++i]);
+		else if (arg == "--iterations" && hasValue)parameters.iterations = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--font" && hasValue)fontPath = argv[++i];
+		else if (arg == "--out" && hasValue)outPath = argv[++i];
+		else {
+			std::cerr << "usage: " << argv[0] << " [--buttons N] [--depth D] [--items M] [--chars K]"
+				<< " [--iterations I] [--font path] [--out file.json] [--sweep]\n";
+			return 2;
+		}
+	}
+
+	sf::Font font;
+	if (!font.loadFromFile(fontPath)) {
+		std::cerr << "could not load font " << fontPath << "\n";
+		return 1;
+	}
+
+	// a sweep varies one parameter at a time around the given scene
+	std::vector<Parameters> scenes = { parameters };
+	if (sweep) {
+		for (int buttons : { 10, 100, 1000, 5000 }) { Parameters p = parameters; p.buttons = buttons; scenes.push_back(p); }
+		for (int depth : { 0, 1, 4, 8 }) { Parameters p = parameters; p.depth = depth; scenes.push_back(p); }
+		for (int items : { 1, 100, 1000 }) { Parameters p = parameters; p.items = items; scenes.push_back(p); }
+		for (int chars : { 10, 1000, 10000 }) { Parameters p = parameters; p.chars = chars; scenes.push_back(p); }
+	}
+
+	std::vector<SceneResult> results;
+	bool withinBudgets = true;
+	for (auto& scene : scenes) {
+		SceneResult result;
+		if (!runScene(scene, font, result)) {
+			std::cerr << "could not create the offscreen target\n";
+			return 1;
+		}
+		if (!result.budgets.passed) {
+			std::cerr << "static page over budget : " << result.budgets.page.drawCalls << " draw calls, "
+				<< result.budgets.page.surfacesCreated << " surfaces created, " << result.budgets.redrawnChildren << " children redrawn\n";
+			withinBudgets = false;
+		}
+		if (!result.traversal.passed) {
+			std::cerr << "page traversal touched its children : " << result.traversal.movedChildren << " moved, "
+				<< result.traversal.transformChanges << " transform changes in " << result.traversal.probeDraws << " probe draws\n";
+			withinBudgets = false;
+		}
+		results.push_back(result);
+	}
+
+	if (outPath.empty())writeJson(std::cout, results);
+	else {
+		std::ofstream file(outPath);
+		writeJson(file, results);
+		if (!file) {
+			std::cerr << "could not write " << outPath << "\n";
+			return 1;
+		}
+	}
+
+	// budgets fail the run after the results are written
+	return withinBudgets ? 0 : 3;
+}
@@ -2,6 +2,8 @@
 #include <SFML/Graphics.hpp>
 
 #include "GUI/GUIFrame.hpp"
+#include "GUI/Animator.hpp"
+#include "GUI/Style.hpp"
 #include "GUI/Textbox.hpp"
 #include "GUI/TextButton.hpp"
 #include "GUI/Button.hpp"
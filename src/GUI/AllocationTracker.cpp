@@ -0,0 +1,279 @@
+#include "AllocationTracker.hpp"
+#include "GUIFrame.hpp"
+
+#include <cstdlib>
+#include <new>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+using namespace gui;
+
+/*
+	counts live in plain arrays, nothing here may allocate
+	since it runs inside operator new
+*/
+static AllocationTracker::Count counts[AllocationTracker::PHASE_COUNT][AllocationTracker::classCount];
+static unsigned long long runs[AllocationTracker::PHASE_COUNT];
+
+// state of the thread running the frame
+static thread_local AllocationTracker::Phase currentPhase = AllocationTracker::NONE;
+static thread_local unsigned int currentClass = 0;
+
+AllocationTracker::PhaseScope::PhaseScope(Phase phase)
+{
+	m_previous = currentPhase;
+	if (currentPhase != NONE)return;
+
+	currentPhase = phase;
+	runs[phase]++;
+}
+
+AllocationTracker::PhaseScope::~PhaseScope()
+{
+	currentPhase = m_previous;
+}
+
+AllocationTracker::ClassScope::ClassScope(unsigned int classID)
+{
+	m_previous = currentClass;
+	currentClass = classID % classCount;
+}
+
+AllocationTracker::ClassScope::~ClassScope()
+{
+	currentClass = m_previous;
+}
+
+void AllocationTracker::record(std::size_t bytes)
+{
+	if (currentPhase == NONE)return;
+
+	Count& count = counts[currentPhase][currentClass];
+	count.allocations++;
+	count.bytes += bytes;
+}
+
+AllocationTracker::Count AllocationTracker::get(Phase phase)
+{
+	Count total = { 0, 0 };
+	for (unsigned int i = 0; i < classCount; i++) {
+		total.allocations += counts[phase][i].allocations;
+		total.bytes += counts[phase][i].bytes;
+	}
+	return total;
+}
+
+AllocationTracker::Count AllocationTracker::get(Phase phase, unsigned int classID)
+{
+	return counts[phase][classID % classCount];
+}
+
+unsigned long long AllocationTracker::getRunCount(Phase phase)
+{
+	return runs[phase];
+}
+
+void AllocationTracker::reset()
+{
+	for (int phase = 0; phase < PHASE_COUNT; phase++) {
+		runs[phase] = 0;
+		for (unsigned int i = 0; i < classCount; i++)counts[phase][i] = { 0, 0 };
+	}
+}
+
+void AllocationTracker::report(std::ostream& out)
+{
+	for (int i = UPDATE; i < PHASE_COUNT; i++) {
+		Phase phase = (Phase)i;
+		unsigned long long n = runs[phase];
+		Count total = get(phase);
+
+		out << getPhaseName(phase) << " : " << n << " runs";
+		if (n == 0) {
+			out << "\n";
+			continue;
+		}
+		out << ", " << (double)total.allocations / n << " allocations and " << (double)total.bytes / n << " bytes per run\n";
+
+		for (unsigned int classID = 0; classID < classCount; classID++) {
+			const Count& count = counts[phase][classID];
+			if (count.allocations == 0)continue;
+
+			out << "\t" << getClassName(classID) << " : " << (double)count.allocations / n << " allocations, "
+				<< (double)count.bytes / n << " bytes\n";
+		}
+	}
+}
+
+const char* AllocationTracker::getPhaseName(Phase phase)
+{
+	switch (phase) {
+	case UPDATE: return "update";
+	case EVENTS: return "events";
+	case DRAW: return "draw";
+	default: return "none";
+	}
+}
+
+const char* AllocationTracker::getClassName(unsigned int classID)
+{
+	switch (classID) {
+	case 0: return "Frame";
+	case GUI_ID_TEXTBOX: return "Textbox";
+	case GUI_ID_BUTTON: return "Button";
+	case GUI_ID_TEXTBUTTON: return "TextButton";
+	case GUI_ID_SLIDER: return "Slider";
+	case GUI_ID_SCROLL: return "Scroll";
+	case GUI_ID_DROPDOWN: return "Dropdown";
+	case GUI_ID_PAGE: return "Page";
+	default: return "unknown";
+	}
+}
+
+////////////////////////////////////////////////////////////
+// replaced global allocation functions
+////////////////////////////////////////////////////////////
+
+#ifdef GUI_TRACK_ALLOCATIONS
+
+static void* allocate(std::size_t size)
+{
+	AllocationTracker::record(size);
+
+	void* pointer = std::malloc(size ? size : 1);
+	if (pointer == nullptr)throw std::bad_alloc();
+	return pointer;
+}
+
+void* operator new(std::size_t size)
+{
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+	return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	AllocationTracker::record(size);
+	return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	AllocationTracker::record(size);
+	return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+	std::free(pointer);
+}
+
+// over-aligned types, memory of those is released by the aligned deletes only
+static void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+{
+	AllocationTracker::record(size);
+
+	std::size_t align = (std::size_t)alignment;
+	if (size == 0)size = 1;
+#ifdef _MSC_VER
+	return _aligned_malloc(size, align);
+#else
+	// size of aligned_alloc must be a multiple of the alignment
+	return std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+}
+
+static void releaseAligned(void* pointer) noexcept
+{
+#ifdef _MSC_VER
+	_aligned_free(pointer);
+#else
+	std::free(pointer);
+#endif
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	void* pointer = allocateAligned(size, alignment);
+	if (pointer == nullptr)throw std::bad_alloc();
+	return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	void* pointer = allocateAligned(size, alignment);
+	if (pointer == nullptr)throw std::bad_alloc();
+	return pointer;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+	releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+	releaseAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	releaseAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	releaseAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	releaseAligned(pointer);
+}
+
+#endif
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+////////////////////////////////////////////////////////////
+/// Allocation tracking macros
+///
+/// Define GUI_TRACK_ALLOCATIONS to replace the global operator new
+/// and count heap allocations made during the phases of gui::Frame.
+/// Without it the macros expand to nothing and operator new is untouched.
+///
+////////////////////////////////////////////////////////////
+#ifdef GUI_TRACK_ALLOCATIONS
+#define GUI_TRACK_CONCAT_IMPL(a, b) a##b
+#define GUI_TRACK_CONCAT(a, b) GUI_TRACK_CONCAT_IMPL(a, b)
+#define GUI_TRACK_PHASE(phase) gui::AllocationTracker::PhaseScope GUI_TRACK_CONCAT(guiTrackPhase, __LINE__)(gui::AllocationTracker::phase)
+#define GUI_TRACK_CLASS(entity) gui::AllocationTracker::ClassScope GUI_TRACK_CONCAT(guiTrackClass, __LINE__)(gui::Entity::getClassID(entity))
+#else
+#define GUI_TRACK_PHASE(phase)
+#define GUI_TRACK_CLASS(entity)
+#endif
+
+namespace gui {
+
+////////////////////////////////////////////////////////////
+/// \brief Counts heap allocations by Frame phase and gui class Id
+///
+/// Allocations are only counted on the thread running a phase, and
+/// attributed to the class of the innermost entity being processed,
+/// class Id 0 if the frame itself allocates.
+///
+////////////////////////////////////////////////////////////
+class AllocationTracker {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Enumeration of the tracked phases
+	///
+	////////////////////////////////////////////////////////////
+	enum Phase { NONE, UPDATE, EVENTS, DRAW, PHASE_COUNT };
+
+	////////////////////////////////////////////////////////////
+	/// \brief Number of class Ids, class Ids take the upper 8 bits of gui Ids
+	///
+	////////////////////////////////////////////////////////////
+	static const unsigned int classCount = 256;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Allocations counted in a phase
+	///
+	////////////////////////////////////////////////////////////
+	struct Count {
+		unsigned long long allocations;		/// < number of calls to operator new
+		unsigned long long bytes;			/// < bytes requested
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sets the phase from construction to destruction
+	///
+	/// Nested phases keep the outer phase
+	///
+	////////////////////////////////////////////////////////////
+	class PhaseScope {
+	public:
+		PhaseScope(Phase phase);
+		~PhaseScope();
+
+	private:
+		Phase m_previous;	/// < phase before construction
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sets the class Id from construction to destruction
+	///
+	////////////////////////////////////////////////////////////
+	class ClassScope {
+	public:
+		ClassScope(unsigned int classID);
+		~ClassScope();
+
+	private:
+		unsigned int m_previous;	/// < class Id before construction
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Count an allocation, called by operator new
+	///
+	////////////////////////////////////////////////////////////
+	static void record(std::size_t bytes);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the allocations of a phase for every class
+	///
+	////////////////////////////////////////////////////////////
+	static Count get(Phase phase);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the allocations of a phase attributed to a class
+	///
+	////////////////////////////////////////////////////////////
+	static Count get(Phase phase, unsigned int classID);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of times a phase was entered
+	///
+	////////////////////////////////////////////////////////////
+	static unsigned long long getRunCount(Phase phase);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set every count to zero
+	///
+	////////////////////////////////////////////////////////////
+	static void reset();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write allocations per run of each phase, by class
+	///
+	////////////////////////////////////////////////////////////
+	static void report(std::ostream& out);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the display name of a phase
+	///
+	////////////////////////////////////////////////////////////
+	static const char* getPhaseName(Phase phase);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the display name of a gui class Id
+	///
+	////////////////////////////////////////////////////////////
+	static const char* getClassName(unsigned int classID);
+};
+
+} // namespace gui
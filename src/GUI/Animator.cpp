@@ -0,0 +1,235 @@
+#include "Animator.hpp"
+#include "GUIFrame.hpp"
+#include "Button.hpp"
+#include "Textbox.hpp"
+#include "TextButton.hpp"
+#include "Page.hpp"
+
+#include <algorithm>
+
+using namespace gui;
+
+// coefficients of t^3, t^2 and t of every easing curve, each one goes from 0 to 1
+static const float curves[][3] = {
+	{ 0, 0, 1 },	// LINEAR
+	{ 0, 1, 0 },	// QUAD_IN
+	{ 0, -1, 2 },	// QUAD_OUT
+	{ 1, 0, 0 },	// CUBIC_IN
+	{ 1, -3, 3 },	// CUBIC_OUT
+	{ -2, 3, 0 }	// SMOOTH
+};
+
+static bool hasFillColor(const Entity& entity)
+{
+	unsigned int classID = Entity::getClassID(entity);
+	return classID == GUI_ID_BUTTON || classID == GUI_ID_TEXTBOX || classID == GUI_ID_TEXTBUTTON;
+}
+static sf::Uint8 toByte(float value)
+{
+	return (sf::Uint8)(std::min(std::max(value, 0.f), 255.f) + 0.5f);
+}
+static void write(Entity& entity, Animator::Property property, const float* value)
+{
+	switch (property) {
+	case Animator::Property::POSITION:
+		entity.setPosition(value[0], value[1]);
+		break;
+	case Animator::Property::SCALE:
+		entity.setScale(value[0], value[1]);
+		break;
+	case Animator::Property::FILL_COLOR: {
+		// styled widgets keep their style and geometry, the color is applied when they are drawn
+		sf::Color color(toByte(value[0]), toByte(value[1]), toByte(value[2]), toByte(value[3]));
+		unsigned int classID = Entity::getClassID(entity);
+		if (classID == GUI_ID_BUTTON)((Button&)entity).setFillOverride(color);
+		else if (classID == GUI_ID_TEXTBUTTON)((TextButton&)entity).setFillOverride(color);
+		else ((Textbox&)entity).setBoxFillColor(color);
+		break;
+	}
+	case Animator::Property::SCROLL: {
+		Page& page = (Page&)entity;
+		sf::FloatRect region = page.getActiveRegion();
+		page.moveActiveRegion(value[0] - region.left, value[1] - region.top);
+		break;
+	}
+	}
+}
+template <typename T>
+static void removeAt(std::vector<T>& values, std::size_t index)
+{
+	values[index] = values.back();
+	values.pop_back();
+}
+
+Animator::Animator()
+{
+	m_hasTime = false;
+	m_applying = false;
+}
+
+void Animator::animatePosition(Entity& entity, const sf::Vector2f& position, sf::Time duration, Easing easing)
+{
+	float from[componentCount] = { entity.getPosition().x, entity.getPosition().y, 0, 0 };
+	float to[componentCount] = { position.x, position.y, 0, 0 };
+	add(entity, Property::POSITION, from, to, duration, easing);
+}
+void Animator::animateScale(Entity& entity, const sf::Vector2f& scale, sf::Time duration, Easing easing)
+{
+	float from[componentCount] = { entity.getScale().x, entity.getScale().y, 0, 0 };
+	float to[componentCount] = { scale.x, scale.y, 0, 0 };
+	add(entity, Property::SCALE, from, to, duration, easing);
+}
+void Animator::animateFillColor(Entity& entity, const sf::Color& color, sf::Time duration, Easing easing)
+{
+	if (!hasFillColor(entity))return;
+
+	sf::Color current = Entity::getClassID(entity) == GUI_ID_BUTTON ? ((Button&)entity).getFillColor() : ((Textbox&)entity).getBoxFillColor();
+	float from[componentCount] = { (float)current.r, (float)current.g, (float)current.b, (float)current.a };
+	float to[componentCount] = { (float)color.r, (float)color.g, (float)color.b, (float)color.a };
+	add(entity, Property::FILL_COLOR, from, to, duration, easing);
+}
+void Animator::animateScroll(Page& page, const sf::Vector2f& corner, sf::Time duration, Easing easing)
+{
+	sf::FloatRect region = page.getActiveRegion();
+	float from[componentCount] = { region.left, region.top, 0, 0 };
+	float to[componentCount] = { corner.x, corner.y, 0, 0 };
+	add(page, Property::SCROLL, from, to, duration, easing);
+}
+void Animator::add(Entity& entity, Property property, const float* from, const float* to, sf::Time duration, Easing easing)
+{
+	std::size_t index = find(entity.getHandle(), property);
+
+	if (duration <= sf::Time::Zero) {
+		if (index != npos)remove(index);
+		write(entity, property, to);
+		return;
+	}
+
+	// a running animation towards the same value is not restarted
+	if (index != npos) {
+		bool sameTarget = true;
+		for (int k = 0; k < componentCount; k++)sameTarget = sameTarget && m_to[k][index] == to[k];
+		if (sameTarget)return;
+	}
+	else {
+		index = m_handles.size();
+		m_handles.push_back(entity.getHandle());
+		m_properties.push_back(property);
+		m_elapsed.push_back(0);
+		m_rate.push_back(0);
+		m_clocked.push_back(0);
+		for (int c = 0; c < 3; c++)m_curve[c].push_back(0);
+		for (int k = 0; k < componentCount; k++) {
+			m_from[k].push_back(0);
+			m_to[k].push_back(0);
+		}
+	}
+
+	m_elapsed[index] = 0;
+	m_rate[index] = 1.f / duration.asSeconds();
+	m_clocked[index] = 0;
+	for (int c = 0; c < 3; c++)m_curve[c][index] = curves[(int)easing][c];
+	for (int k = 0; k < componentCount; k++) {
+		m_from[k][index] = from[k];
+		m_to[k][index] = to[k];
+	}
+}
+std::size_t Animator::find(const Handle& handle, Property property) const
+{
+	for (std::size_t i = 0; i < m_handles.size(); i++) {
+		if (m_handles[i] == handle && m_properties[i] == property)return i;
+	}
+	return npos;
+}
+void Animator::stop(const Entity& entity, Property property)
+{
+	std::size_t index = find(entity.getHandle(), property);
+	if (index != npos)remove(index);
+}
+void Animator::stop(const Entity& entity)
+{
+	for (std::size_t i = m_handles.size(); i-- > 0;) {
+		if (m_handles[i] == entity.getHandle())remove(i);
+	}
+}
+bool Animator::isAnimating(const Entity& entity, Property property) const
+{
+	return find(entity.getHandle(), property) != npos;
+}
+bool Animator::isRunning() const
+{
+	return !m_handles.empty();
+}
+std::size_t Animator::getCount() const
+{
+	return m_handles.size();
+}
+void Animator::update(sf::Time time)
+{
+	// a replaced input source may restart its clock
+	float delta = m_hasTime ? std::max((time - m_time).asSeconds(), 0.f) : 0;
+	m_time = time;
+	m_hasTime = true;
+
+	std::size_t count = m_handles.size();
+	if (count == 0)return;
+
+	m_eased.resize(count);
+	for (int k = 0; k < componentCount; k++)m_value[k].resize(count);
+
+	// animations added since the last update start now
+	for (std::size_t i = 0; i < count; i++) {
+		m_elapsed[i] += delta * m_clocked[i];
+		m_clocked[i] = 1;
+	}
+
+	// progress through the curve, evaluated by Horner's rule
+	for (std::size_t i = 0; i < count; i++) {
+		float t = std::min(m_elapsed[i] * m_rate[i], 1.f);
+		m_eased[i] = ((m_curve[0][i] * t + m_curve[1][i]) * t + m_curve[2][i]) * t;
+	}
+
+	// weighted form so that the end value is reached exactly
+	for (int k = 0; k < componentCount; k++) {
+		for (std::size_t i = 0; i < count; i++)
+			m_value[k][i] = m_from[k][i] * (1 - m_eased[i]) + m_to[k][i] * m_eased[i];
+	}
+
+	// setters may start animations, those are appended or restarted and wait for the next update
+	m_applying = true;
+	for (std::size_t i = 0; i < count; i++) {
+		Entity* entity = Entity::get(m_handles[i]);
+		if (entity != nullptr && m_clocked[i] != 0)apply(*entity, i);
+	}
+	m_applying = false;
+
+	for (std::size_t i = count; i-- > 0;) {
+		bool finished = m_clocked[i] != 0 && m_elapsed[i] * m_rate[i] >= 1;
+		if (finished || Entity::get(m_handles[i]) == nullptr)remove(i);
+	}
+}
+void Animator::apply(Entity& entity, std::size_t index) const
+{
+	float value[componentCount];
+	for (int k = 0; k < componentCount; k++)value[k] = m_value[k][index];
+	write(entity, m_properties[index], value);
+}
+void Animator::remove(std::size_t index)
+{
+	// indices must not move while values are applied, the update removes it afterwards
+	if (m_applying) {
+		m_handles[index] = Handle();
+		return;
+	}
+
+	removeAt(m_handles, index);
+	removeAt(m_properties, index);
+	removeAt(m_elapsed, index);
+	removeAt(m_rate, index);
+	removeAt(m_clocked, index);
+	for (int c = 0; c < 3; c++)removeAt(m_curve[c], index);
+	for (int k = 0; k < componentCount; k++) {
+		removeAt(m_from[k], index);
+		removeAt(m_to[k], index);
+	}
+}
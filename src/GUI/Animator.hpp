@@ -0,0 +1,192 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "SlotMap.hpp"
+#include <vector>
+
+namespace gui {
+
+class Entity;
+class Page;
+
+////////////////////////////////////////////////////////////
+/// \brief Eases properties of entities from their current value
+///		   to a target over time
+///
+/// Animations are stored as parallel arrays, one update advances
+/// every animation in a few flat passes over them and only then
+/// writes the values to the entities. Every easing curve is a cubic
+/// polynomial, so no pass branches on the curve.
+///
+/// An entity has at most one animation per property, animating a
+/// property again replaces its animation. Animations of destroyed
+/// entities are dropped on the next update.
+///
+////////////////////////////////////////////////////////////
+class Animator {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Enumeration of the animated properties
+	///
+	////////////////////////////////////////////////////////////
+	enum class Property { POSITION, SCALE, FILL_COLOR, SCROLL };
+
+	////////////////////////////////////////////////////////////
+	/// \brief Enumeration of the easing curves
+	///
+	////////////////////////////////////////////////////////////
+	enum class Easing { LINEAR, QUAD_IN, QUAD_OUT, CUBIC_IN, CUBIC_OUT, SMOOTH };
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor, no animation is running
+	///
+	////////////////////////////////////////////////////////////
+	Animator();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move an entity to a position
+	///
+	/// \param entity -> Animated entity
+	/// \param position -> Position at the end of the animation
+	/// \param duration -> Duration of the animation, zero sets the position at once
+	/// \param easing -> Curve of the animation
+	///
+	////////////////////////////////////////////////////////////
+	void animatePosition(Entity& entity, const sf::Vector2f& position, sf::Time duration, Easing easing = Easing::SMOOTH);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scale an entity to a scale factor
+	///
+	/// \param entity -> Animated entity
+	/// \param scale -> Scale factors at the end of the animation
+	/// \param duration -> Duration of the animation, zero sets the scale at once
+	/// \param easing -> Curve of the animation
+	///
+	////////////////////////////////////////////////////////////
+	void animateScale(Entity& entity, const sf::Vector2f& scale, sf::Time duration, Easing easing = Easing::SMOOTH);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Fade the fill color of a button, textbox or text button
+	///		   Other entities have no fill color and are ignored
+	///
+	/// Buttons and text buttons show the color through their fill
+	/// override, in the normal state only, and keep their style.
+	///
+	/// \param entity -> Animated entity
+	/// \param color -> Fill color at the end of the animation
+	/// \param duration -> Duration of the animation, zero sets the color at once
+	/// \param easing -> Curve of the animation
+	///
+	////////////////////////////////////////////////////////////
+	void animateFillColor(Entity& entity, const sf::Color& color, sf::Time duration, Easing easing = Easing::SMOOTH);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scroll the active region of a page to a top left corner
+	///
+	/// \param page -> Animated page
+	/// \param corner -> Top left corner of the active region at the end
+	///		   of the animation, limited to the page like moveActiveRegion
+	/// \param duration -> Duration of the animation, zero scrolls at once
+	/// \param easing -> Curve of the animation
+	///
+	////////////////////////////////////////////////////////////
+	void animateScroll(Page& page, const sf::Vector2f& corner, sf::Time duration, Easing easing = Easing::SMOOTH);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Stop the animation of a property, the property keeps its current value
+	///
+	////////////////////////////////////////////////////////////
+	void stop(const Entity& entity, Property property);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Stop every animation of an entity
+	///
+	////////////////////////////////////////////////////////////
+	void stop(const Entity& entity);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if a property of an entity is animated
+	///
+	////////////////////////////////////////////////////////////
+	bool isAnimating(const Entity& entity, Property property) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if any animation is running
+	///
+	////////////////////////////////////////////////////////////
+	bool isRunning() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of running animations
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Advance every animation and apply the values
+	///
+	/// Animations added since the previous update start at this update,
+	/// so time spent idle before they were added is not counted.
+	///
+	/// \param time -> Current time of the clock driving the animations, time going back is ignored
+	///
+	////////////////////////////////////////////////////////////
+	void update(sf::Time time);
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Start an animation, or restart the running one of
+	///		   the property unless it already has the same target
+	///
+	/// \param from -> Current value, up to four components
+	/// \param to -> Value at the end of the animation
+	///
+	////////////////////////////////////////////////////////////
+	void add(Entity& entity, Property property, const float* from, const float* to, sf::Time duration, Easing easing);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the animation of a property
+	///
+	/// \return Index of the animation, npos if the property is not animated
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t find(const Handle& handle, Property property) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write the current value of an animation to its entity
+	///
+	////////////////////////////////////////////////////////////
+	void apply(Entity& entity, std::size_t index) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove an animation, the last one takes its index
+	///		   unless values are being applied
+	///
+	////////////////////////////////////////////////////////////
+	void remove(std::size_t index);
+
+	static const std::size_t npos = ~std::size_t(0);	/// < index of animations which do not exist
+	static const int componentCount = 4;				/// < components of a value, colors use all four
+
+
+	////////////////////////////////////////////////////////////
+	// Member Data
+	////////////////////////////////////////////////////////////
+
+	std::vector<Handle> m_handles;						/// < handle of the animated entity
+	std::vector<Property> m_properties;					/// < animated property
+	std::vector<float> m_elapsed;						/// < seconds since the start
+	std::vector<float> m_rate;							/// < inverse of the duration in seconds
+	std::vector<float> m_clocked;						/// < 1 once the animation has been updated, 0 before
+	std::vector<float> m_curve[3];						/// < coefficients of t^3, t^2 and t of the easing curve
+	std::vector<float> m_from[componentCount];			/// < value at the start
+	std::vector<float> m_to[componentCount];			/// < value at the end
+	std::vector<float> m_eased;							/// < eased progress computed by the last update
+	std::vector<float> m_value[componentCount];			/// < value computed by the last update
+	sf::Time m_time;									/// < time of the last update
+	bool m_hasTime;										/// < whether update was called once
+	bool m_applying;									/// < whether the update is writing values to the entities
+};
+
+} // namespace gui
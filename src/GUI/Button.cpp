@@ -6,15 +6,14 @@ Button::Button()
 {
 	actionEvent = ActionEvent::RELEASE;
 
-	m_second_ScaleFactor.x = m_second_ScaleFactor.y = 1;
-	m_second_OutlineThickness = 0;
-	m_second_FillColor = sf::Color::White;
-	m_second_OutlineColor = sf::Color::White;
+	m_look.applyLook(*this);
 }
 
 void Button::setPointCount(std::size_t count)
 {
 	m_shape.setPointCount(count);
+	m_look.invalidateMeshes();
+	invalidate();
 }
 std::size_t Button::getPointCount() const
 {
@@ -23,106 +22,110 @@ std::size_t Button::getPointCount() const
 void Button::setPoint(std::size_t index, const sf::Vector2f& point)
 {
 	m_shape.setPoint(index, point);
+	m_look.invalidateMeshes();
+	invalidate();
 }
 sf::Vector2f Button::getPoint(std::size_t index) const
 {
 	return m_shape.getPoint(index);
 }
-void Button::switchProperties()
-{
-	auto fillColor = m_shape.getFillColor();
-	auto outlineColor = m_shape.getOutlineColor();
-	auto outlineThickness = m_shape.getOutlineThickness();
-	auto scaleFactor = getScale();
-
-	m_shape.setFillColor(m_second_FillColor);
-	m_shape.setOutlineColor(m_second_OutlineColor);
-	m_shape.setOutlineThickness(m_second_OutlineThickness);
-	setScale(m_second_ScaleFactor);
-
-	m_second_FillColor = fillColor;
-	m_second_OutlineColor = outlineColor;
-	m_second_OutlineThickness = outlineThickness;
-	m_second_ScaleFactor = scaleFactor;
-}
 
 void Button::setFillColor(const sf::Color& color)
 {
-	if (m_selected) m_second_FillColor = color;
-	else m_shape.setFillColor(color);
+	m_look.clearFillOverride(*this);
+	m_look.restyle(*this, false, [&color](Style::Look& look) { look.fillColor = color; });
+}
+void Button::setFillOverride(const sf::Color& color)
+{
+	m_look.setFillOverride(*this, color);
+}
+void Button::clearFillOverride()
+{
+	m_look.clearFillOverride(*this);
 }
 void Button::setOutlineColor(const sf::Color& color)
 {
-	if (m_selected) m_second_OutlineColor = color;
-	else m_shape.setOutlineColor(color);
+	m_look.restyle(*this, false, [&color](Style::Look& look) { look.outlineColor = color; });
 }
 void Button::setOutlineThickness(float thickness)
 {
-	if (m_selected) m_second_OutlineThickness = thickness;
-	else m_shape.setOutlineThickness(thickness);
+	m_look.restyle(*this, false, [thickness](Style::Look& look) { look.outlineThickness = thickness; });
 }
 void Button::setSelectionFillColor(const sf::Color& color)
 {
-	if (m_selected) m_shape.setFillColor(color);
-	else m_second_FillColor = color;
+	m_look.restyle(*this, true, [&color](Style::Look& look) { look.fillColor = color; });
 }
 void Button::setSelectionOutlineColor(const sf::Color& color)
 {
-	if (m_selected) m_shape.setOutlineColor(color);
-	else m_second_OutlineColor = color;
+	m_look.restyle(*this, true, [&color](Style::Look& look) { look.outlineColor = color; });
 }
 void Button::setSelectionOutlineThickness(float thickness)
 {
-	if (m_selected) m_shape.setOutlineThickness(thickness);
-	else m_second_OutlineThickness = thickness;
+	m_look.restyle(*this, true, [thickness](Style::Look& look) { look.outlineThickness = thickness; });
 }
 void Button::setSelectionScale(const sf::Vector2f& scaleFactor)
 {
-	if (m_selected) setScale(scaleFactor);
-	else m_second_ScaleFactor = scaleFactor;
+	m_look.restyle(*this, true, [&scaleFactor](Style::Look& look) { look.scale = scaleFactor; });
+}
+void Button::setSelectionTransition(sf::Time duration, Animator::Easing easing)
+{
+	m_look.setTransition(duration, easing);
+}
+void Button::setButtonStyle(const std::shared_ptr<const Style>& style)
+{
+	m_look.setStyle(*this, style);
+}
+void Button::setButtonTheme(const std::shared_ptr<const Theme>& theme)
+{
+	m_look.setTheme(*this, theme);
 }
 void Button::setTexture(const sf::Texture* texture, bool resetRect)
 {
 	m_shape.setTexture(texture, resetRect);
+	m_look.invalidateMeshes();
+	invalidate();
 }
 void Button::setTextureRect(const sf::IntRect& rect)
 {
 	m_shape.setTextureRect(rect);
+	m_look.invalidateMeshes();
+	invalidate();
 }
 sf::Color gui::Button::getFillColor()
 {
-	if (m_selected) return m_second_FillColor;
-	else return m_shape.getFillColor();
+	return m_look.getFillColor();
 }
 sf::Color gui::Button::getOutlineColor()
 {
-	if (m_selected) return m_second_OutlineColor;
-	else return m_shape.getOutlineColor();
+	return m_look.getLook(Style::NORMAL).outlineColor;
 }
 float gui::Button::getOutlineThickness()
 {
-	if (m_selected) return m_second_OutlineThickness;
-	else return m_shape.getOutlineThickness();
+	return m_look.getLook(Style::NORMAL).outlineThickness;
 }
 sf::Color gui::Button::getSelectionFillColor()
 {
-	if (!m_selected) return m_second_FillColor;
-	else return m_shape.getFillColor();
+	return m_look.getLook(Style::HOVER).fillColor;
 }
 sf::Color gui::Button::getSelectionOutlineColor()
 {
-	if (!m_selected) return m_second_OutlineColor;
-	else return m_shape.getOutlineColor();
+	return m_look.getLook(Style::HOVER).outlineColor;
 }
 float gui::Button::getSelectionOutlineThickness()
 {
-	if (!m_selected) return m_second_OutlineThickness;
-	else return m_shape.getOutlineThickness();
+	return m_look.getLook(Style::HOVER).outlineThickness;
 }
 sf::Vector2f gui::Button::getSelectionScale()
 {
-	if (!m_selected) return m_second_ScaleFactor;
-	else return getScale();
+	return m_look.getLook(Style::HOVER).scale;
+}
+const std::shared_ptr<const Style>& Button::getButtonStyle() const
+{
+	return m_look.getStyle();
+}
+const std::shared_ptr<const Theme>& Button::getButtonTheme() const
+{
+	return m_look.getTheme();
 }
 const sf::Texture* Button::getTexture() const
 {
@@ -134,11 +137,16 @@ const sf::IntRect& Button::getTextureRect() const
 }
 sf::FloatRect Button::getLocalBounds() const
 {
-	return m_shape.getLocalBounds();
+	return m_look.getMesh(*this, m_shape).bounds;
 }
 sf::FloatRect Button::getGlobalBounds() const
 {
-	return getTransform().transformRect(m_shape.getGlobalBounds());
+	return getTransform().transformRect(m_look.getMesh(*this, m_shape).bounds);
+}
+sf::FloatRect Button::getDrawBounds() const
+{
+	// bounds of the shape include its outline
+	return getGlobalBounds();
 }
 bool Button::contains(const sf::Vector2f& point) const
 {
@@ -152,18 +160,30 @@ Entity* Button::isHit(const sf::Vector2f& point)
 }
 void Button::activateSelection()
 {
+	m_look.saveRestScale(*this);
 	m_selected = true;
-	switchProperties();
+	m_look.applyLook(*this);
 }
 void Button::deactivateSelection()
 {
+	m_look.restoreRestScale(*this);
 	m_selected = false;
-	switchProperties();
+	m_look.applyLook(*this);
+}
+void Button::activatePress()
+{
+	m_pressed = true;
+	m_look.applyLook(*this);
+}
+void Button::deactivatePress()
+{
+	m_pressed = false;
+	m_look.applyLook(*this);
 }
-void Button::draw(sf::RenderTarget& target, sf::RenderStates states) const
+void Button::submit(RenderBatch& batch, sf::RenderStates states) const
 {
 	if (isActive()) {
 		states.transform *= getTransform();
-		target.draw(m_shape, states);
+		m_look.submit(batch, *this, m_shape, states);
 	}
 }
\ No newline at end of file
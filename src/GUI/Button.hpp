@@ -1,5 +1,6 @@
 #pragma once
 #include "GUIFrame.hpp"
+#include "StyledShape.hpp"
 
 namespace gui
 {
@@ -69,6 +70,24 @@ public:
 	////////////////////////////////////////////////////////////
 	void setFillColor(const sf::Color& color);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Show a fill color when the shape is not selected,
+	///		   without changing the style of the button
+	///
+	/// Cheap enough to be called every frame, the animator fades
+	/// the fill color through it. Setting the fill color clears it.
+	/// 
+	/// \param color -> fill color shown in place of that of the style
+	///
+	////////////////////////////////////////////////////////////
+	void setFillOverride(const sf::Color& color);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show the fill color of the style again
+	///
+	////////////////////////////////////////////////////////////
+	void clearFillOverride();
+
 	////////////////////////////////////////////////////////////
 	/// \brief Set the outline color of the shape
 	///
@@ -124,6 +143,38 @@ public:
 	////////////////////////////////////////////////////////////
 	void setSelectionScale(const sf::Vector2f& scaleFactor);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Ease the scale of the shape when it is selected, pressed or deselected
+	/// 
+	/// \param duration -> duration of the change of scale, zero to set it at once
+	/// \param easing -> curve of the change of scale
+	///
+	////////////////////////////////////////////////////////////
+	void setSelectionTransition(sf::Time duration, Animator::Easing easing = Animator::Easing::SMOOTH);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the looks of the shape in every state
+	///
+	/// The style is shared, not copied : widgets with the same
+	/// style hold the same object. Look setters afterwards give
+	/// this button its own modified copy.
+	/// 
+	/// \param style -> new style, must not be nullptr
+	///
+	////////////////////////////////////////////////////////////
+	void setButtonStyle(const std::shared_ptr<const Style>& style);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show the style of a theme, swapped with the theme
+	///
+	/// The button follows the theme until a style is set or a
+	/// look setter gives it its own copy of the style.
+	/// 
+	/// \param theme -> theme to follow, must not be nullptr
+	///
+	////////////////////////////////////////////////////////////
+	void setButtonTheme(const std::shared_ptr<const Theme>& theme);
+
 	////////////////////////////////////////////////////////////
 	/// \brief Change the source texture of the shape
 	///
@@ -159,7 +210,7 @@ public:
 	////////////////////////////////////////////////////////////
 	/// \brief Get the fill color of the shape
 	///
-	/// \return fill color of the shape
+	/// \return fill color of the shape, the override if one is set
 	///
 	////////////////////////////////////////////////////////////
 	sf::Color getFillColor();
@@ -212,6 +263,22 @@ public:
 	////////////////////////////////////////////////////////////
 	sf::Vector2f getSelectionScale();
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get the looks of the shape in every state
+	/// 
+	/// \return style of the button, possibly shared with other widgets
+	///
+	////////////////////////////////////////////////////////////
+	const std::shared_ptr<const Style>& getButtonStyle() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the theme followed by the button
+	/// 
+	/// \return theme of the button, nullptr if it has its own style
+	///
+	////////////////////////////////////////////////////////////
+	const std::shared_ptr<const Theme>& getButtonTheme() const;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Get the source texture of the shape
 	///
@@ -294,37 +361,43 @@ public:
 	virtual void deactivateSelection() override;
 
 	////////////////////////////////////////////////////////////
-	/// \brief Draws the object to the target applying its states
-	/// 
-	/// \param target -> Render target to draw to
-	/// \param states -> Current render states
-	/// 
+	/// \brief Actions to take when the left button is pressed on the object
+	///
 	////////////////////////////////////////////////////////////
-	virtual void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const override;
+	virtual void activatePress() override;
 
-private:
 	////////////////////////////////////////////////////////////
-	/// \brief switch properties of shape with second properties
+	/// \brief Actions to take when the press on the object ends
 	///
 	////////////////////////////////////////////////////////////
-	void switchProperties();
-
+	virtual void deactivatePress() override;
 
 	////////////////////////////////////////////////////////////
-	// Member data
+	/// \brief Get the rectangle covered by everything the object draws
+	///
+	/// \return Bounding rectangle of the drawn object in the coordinate
+	///			system of the functional parent
+	///
 	////////////////////////////////////////////////////////////
+	virtual sf::FloatRect getDrawBounds() const override;
 
 	////////////////////////////////////////////////////////////
-	/// \brief Property to change how button looks based on selection and deselection
+	/// \brief Add the geometry of the object to the batch applying its states
+	/// 
+	/// \param batch -> Batch collecting the geometry
+	/// \param states -> Current render states
 	/// 
 	////////////////////////////////////////////////////////////
+	virtual void submit(RenderBatch& batch, sf::RenderStates states = sf::RenderStates::Default) const override;
+
+private:
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+
+	StyledShape m_look;									/// < style and geometry of the shape in every state
 	
-	sf::Color m_second_FillColor;						/// < second color of the shape
-	sf::Color m_second_OutlineColor;					/// < second color of the outline of the shape
-	float m_second_OutlineThickness;					/// < second thickness of the outline of the shape
-	sf::Vector2f m_second_ScaleFactor;					/// < second scale factor of the shape
-	
-	sf::ConvexShape m_shape;							/// < shape of the button
+	sf::ConvexShape m_shape;							/// < points and texture of the button, its colors are those of the style
 };
 
 } // namespace gui
\ No newline at end of file
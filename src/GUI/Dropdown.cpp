@@ -2,11 +2,15 @@
 
 using namespace gui;
 
+const std::size_t Dropdown::noItem;
+
 Dropdown::Dropdown(const sf::Vector2f& headerSize):
 	Entity(GUI_ID_DROPDOWN)
 {
 	m_itemCount = 0;
 	m_itemLimit = 3;
+	m_firstItem = noItem;
+	m_updatingRows = false;
 	m_itemSize.y = headerSize.y;
 	setHeader();
 	setHeaderSize(headerSize);
@@ -21,11 +25,15 @@ Dropdown::Dropdown(const sf::Vector2f& headerSize, float itemHeight, int itemLim
 {
 	m_itemCount = 0;
 	m_itemLimit = itemLimit;
+	m_firstItem = noItem;
+	m_updatingRows = false;
 	m_itemSize.y = itemHeight;
 	setHeader();
 	setHeaderSize(headerSize);
 
 	m_page.setFillColor(sf::Color::Transparent);
+
+	m_functional_object = FunctionalObject::DROPDOWN;
 }
 void Dropdown::setHeader()
 {
@@ -68,6 +76,9 @@ void Dropdown::setHeaderSize(const sf::Vector2f& headerSize)
 	m_page.setMaxSize({ headerSize.x, m_page.getMaxSize().y });
 	m_page.setActiveRegion({ m_page.getActiveRegion().left, m_page.getActiveRegion().top, headerSize.x, m_page.getActiveRegion().height });
 	m_page.setPosition(0, headerSize.y);
+
+	layoutItems(0);
+	if (hasModel())refreshModel();
 }
 void Dropdown::setHeaderColor(const sf::Color& color)
 {
@@ -99,6 +110,8 @@ void Dropdown::setItemLimit(int limit)
 	m_itemLimit = limit;
 
 	m_page.setActiveRegion({ m_page.getActiveRegion().left, m_page.getActiveRegion().top, m_page.getActiveRegion().width, std::min(m_itemLimit, m_itemCount) * (m_itemSize.y + 10) + 10 });
+
+	if (hasModel())refreshModel();
 }
 void Dropdown::setItemHeight(float height)
 {
@@ -106,6 +119,9 @@ void Dropdown::setItemHeight(float height)
 
 	m_page.setMaxSize({ m_header.getSize().x, m_itemCount * (m_itemSize.y + 10) + 10 });
 	m_page.setActiveRegion({ m_page.getActiveRegion().left, m_page.getActiveRegion().top, m_page.getActiveRegion().width, std::min(m_itemLimit, m_itemCount) * (m_itemSize.y + 10) + 10 });
+
+	layoutItems(0);
+	if (hasModel())refreshModel();
 }
 void Dropdown::setTitle(const std::string& title, sf::Font& font, int charSize, const sf::Color& color)
 {
@@ -135,6 +151,10 @@ sf::Vector2f Dropdown::getHeaderSize() const
 {
 	return m_header.getSize();
 }
+const Pointer& Dropdown::getPointer() const
+{
+	return getFunctionalParent()->getPointer();
+}
 sf::Vector2f Dropdown::getMousePosition() const
 {
 	return getInverseTransform().transformPoint(getFunctionalParent()->getMousePosition());
@@ -160,92 +180,225 @@ sf::Vector2f Dropdown::getSize() const
 }
 void Dropdown::addItem(Textbox& textbox)
 {
-	textbox.setSize(m_itemSize);
-	textbox.setOrigin(m_itemSize * 0.5f);
-	textbox.setPosition((m_header.getSize().x - 10) / 2, m_itemCount++ * (m_itemSize.y + 10) + 10 + m_itemSize.y / 2.0f);
-	
-	m_page.addEntity(textbox);
+	insertItems(m_itemCount, { &textbox });
+}
+void gui::Dropdown::addItem(Button& button)
+{
+	insertItems(m_itemCount, { &button });
+}
+void Dropdown::addItems(const std::vector<Textbox*>& textboxes)
+{
+	insertItems(m_itemCount, textboxes);
+}
+void Dropdown::addItems(const std::vector<Button*>& buttons)
+{
+	insertItems(m_itemCount, buttons);
+}
+void Dropdown::insertItem(int where, Textbox& textbox)
+{
+	insertItems(where, { &textbox });
+}
+void gui::Dropdown::insertItem(int where, Button& button)
+{
+	insertItems(where, { &button });
+}
+void Dropdown::insertItems(int where, const std::vector<Textbox*>& textboxes)
+{
+	if (hasModel())removeModel();
 
-	m_page.setMaxSize({ m_header.getSize().x, m_itemCount * (m_itemSize.y + 10) + 10 });
-	m_page.setActiveRegion({ m_page.getActiveRegion().left, m_page.getActiveRegion().top, m_page.getActiveRegion().width, std::min(m_itemLimit, m_itemCount) * (m_itemSize.y + 10) + 10 });
-	m_page.setScroll(Page::ScrollPlacement::RIGHT);
+	// out of range items are inserted at the closest end
+	where = std::max(0, std::min(where, m_itemCount));
+
+	std::vector<unsigned long long> ids;
+	ids.reserve(textboxes.size());
+	for (Textbox* textbox : textboxes) {
+		textbox->setSize(m_itemSize);
+		textbox->setOrigin(m_itemSize * 0.5f);
+		m_page.addEntity(*textbox);
+		ids.push_back(textbox->getID());
+	}
+
+	m_itemIDs.insert(m_itemIDs.begin() + where, ids.begin(), ids.end());
+	m_itemCount += (int)ids.size();
 
-	m_itemIDs.push_back(textbox.getID());
+	layoutItems(where);
+	resizePage();
 }
-void gui::Dropdown::addItem(Button& button)
+void Dropdown::insertItems(int where, const std::vector<Button*>& buttons)
 {
-	button.setPointCount(4);
-	button.setPoint(0, { 0, 0 });
-	button.setPoint(1, { m_itemSize.x, 0 });
-	button.setPoint(2, m_itemSize);
-	button.setPoint(3, { 0, m_itemSize.y });
-	button.setOrigin(m_itemSize * 0.5f);
-	button.setPosition((m_header.getSize().x - 10) / 2, m_itemCount++ * (m_itemSize.y + 10) + 10 + m_itemSize.y / 2.0f);
-	m_page.addEntity(button);
+	if (hasModel())removeModel();
 
-	m_page.setMaxSize({ m_header.getSize().x, m_itemCount * (m_itemSize.y + 10) + 10 });
-	m_page.setActiveRegion({ m_page.getActiveRegion().left, m_page.getActiveRegion().top, m_page.getActiveRegion().width, std::min(m_itemLimit, m_itemCount) * (m_itemSize.y + 10) + 10 });
-	m_page.setScroll(Page::ScrollPlacement::RIGHT);
+	// out of range items are inserted at the closest end
+	where = std::max(0, std::min(where, m_itemCount));
 
-	m_itemIDs.push_back(button.getID());
+	std::vector<unsigned long long> ids;
+	ids.reserve(buttons.size());
+	for (Button* button : buttons) {
+		button->setPointCount(4);
+		button->setPoint(0, { 0, 0 });
+		button->setPoint(1, { m_itemSize.x, 0 });
+		button->setPoint(2, m_itemSize);
+		button->setPoint(3, { 0, m_itemSize.y });
+		button->setOrigin(m_itemSize * 0.5f);
+		m_page.addEntity(*button);
+		ids.push_back(button->getID());
+	}
+
+	m_itemIDs.insert(m_itemIDs.begin() + where, ids.begin(), ids.end());
+	m_itemCount += (int)ids.size();
+
+	layoutItems(where);
+	resizePage();
 }
-void Dropdown::insertItem(int where, Textbox& textbox)
+void Dropdown::eraseItem(int where)
 {
-	textbox.setSize(m_itemSize);
-	textbox.setOrigin(m_itemSize * 0.5f);
-	textbox.setPosition((m_header.getSize().x - 10) / 2, where * (m_itemSize.y + 10) + 10 + m_itemSize.y / 2.0f);
-	m_page.addEntity(textbox);
+	eraseItems(where, 1);
+}
+void Dropdown::eraseItems(int where, int count)
+{
+	// items of a model are not erasable, out of range items do not exist
+	int size = (int)m_itemIDs.size();
+	if (where < 0 || where >= size)return;
+	count = std::min(count, size - where);
+	if (count <= 0)return;
 
-	for (int i = where; i < m_itemCount; i++) {
-		m_page.getByID(m_itemIDs[i])->move(0, m_itemSize.y + 10);
+	for (int i = where; i < where + count; i++) {
+		m_page.removeEntity(m_itemIDs[i]);
 	}
 
-	++m_itemCount;
+	m_itemIDs.erase(m_itemIDs.begin() + where, m_itemIDs.begin() + where + count);
+	m_itemCount -= count;
 
-	m_page.setMaxSize({ m_header.getSize().x, m_itemCount * (m_itemSize.y + 10) + 10 });
-	m_page.setActiveRegion({ m_page.getActiveRegion().left, m_page.getActiveRegion().top, m_page.getActiveRegion().width, std::min(m_itemLimit, m_itemCount) * (m_itemSize.y + 10) + 10 });
-	m_page.setScroll(Page::ScrollPlacement::RIGHT);
+	layoutItems(where);
+	resizePage();
+}
+void Dropdown::setModel(std::function<std::size_t()> count, std::function<std::string(std::size_t)> item, const TextButton& style)
+{
+	// items are either entities or from the model
+	for (unsigned long long id : m_itemIDs)m_page.removeEntity(id);
+	m_itemIDs.clear();
+	removeModel();
 
-	m_itemIDs.insert(m_itemIDs.begin() + where, textbox.getID());
+	m_modelCount = count;
+	m_modelItem = item;
+	m_rowStyle.reset(new TextButton(style));
+	refreshModel();
 }
-void gui::Dropdown::insertItem(int where, Button& button)
+void Dropdown::setModelAction(std::function<void(std::size_t)> action)
+{
+	m_modelAction = action;
+}
+void Dropdown::refreshModel()
 {
-	button.setPointCount(4);
-	button.setPoint(0, { 0, 0 });
-	button.setPoint(1, { m_itemSize.x, 0 });
-	button.setPoint(2, m_itemSize);
-	button.setPoint(3, { 0, m_itemSize.y });
-	button.setOrigin(m_itemSize * 0.5f);
-	button.setPosition((m_header.getSize().x - 10) / 2, where * (m_itemSize.y + 10) + 10 + m_itemSize.y / 2.0f);
-	m_page.addEntity(button);
-
-	for (int i = where; i < m_itemCount; i++) {
-		m_page.getByID(m_itemIDs[i])->move(0, m_itemSize.y + 10);
+	if (!hasModel())return;
+
+	// page changes below would bind rows before the pool is ready
+	m_updatingRows = true;
+
+	m_itemCount = (int)m_modelCount();
+
+	// pool covers a full page plus the row cut at its bottom while scrolling
+	std::size_t poolSize = (std::size_t)std::max(m_itemLimit, 0) + 1;
+	while (m_rows.size() < poolSize) {
+		std::size_t k = m_rows.size();
+		m_rows.push_back(*m_rowStyle);
+		m_rowItems.push_back(noItem);
+
+		TextButton& row = m_rows.back();
+		row.actionEvent = ActionEvent::RELEASE;
+		row.setAction([this, k] {
+			if (m_modelAction && m_rowItems[k] != noItem)m_modelAction(m_rowItems[k]);
+			});
+		m_page.addEntity(row);
+	}
+	while (m_rows.size() > poolSize) {
+		m_page.removeEntity(m_rows.back());
+		m_rows.pop_back();
+		m_rowItems.pop_back();
+	}
+	for (auto& row : m_rows) {
+		row.setSize(m_itemSize);
+		row.setOrigin(m_itemSize * 0.5f);
 	}
 
-	++m_itemCount;
+	resizePage();
 
+	m_updatingRows = false;
+	updateRows(true);
+}
+void Dropdown::removeModel()
+{
+	for (auto& row : m_rows)m_page.removeEntity(row);
+	m_rows.clear();
+	m_rowItems.clear();
+	m_firstItem = noItem;
+
+	if (!hasModel())return;
+
+	m_modelCount = nullptr;
+	m_modelItem = nullptr;
+	m_rowStyle.reset();
+	m_itemCount = 0;
+	resizePage();
+}
+bool Dropdown::hasModel() const
+{
+	return (bool)m_modelCount;
+}
+void Dropdown::resizePage()
+{
 	m_page.setMaxSize({ m_header.getSize().x, m_itemCount * (m_itemSize.y + 10) + 10 });
 	m_page.setActiveRegion({ m_page.getActiveRegion().left, m_page.getActiveRegion().top, m_page.getActiveRegion().width, std::min(m_itemLimit, m_itemCount) * (m_itemSize.y + 10) + 10 });
-	m_page.setScroll(Page::ScrollPlacement::RIGHT);
 
-	m_itemIDs.insert(m_itemIDs.begin() + where, button.getID());
+	// the page rebuilds the scroll it already has when its region changes
+	if (!m_page.hasScroll(Page::ScrollPlacement::RIGHT))m_page.setScroll(Page::ScrollPlacement::RIGHT);
 }
-void Dropdown::eraseItem(int where)
+void Dropdown::layoutItems(int from)
 {
-	m_page.removeEntity(m_itemIDs[where]);
+	// rows of a model are placed by updateRows
+	for (std::size_t i = from; i < m_itemIDs.size(); i++) {
+		Entity* item = m_page.getByID(m_itemIDs[i]);
+		if (item != nullptr)item->setPosition(getItemPosition(i));
+	}
+}
+sf::Vector2f Dropdown::getItemPosition(std::size_t index) const
+{
+	// centre of the item, items are one below the other in index order
+	return sf::Vector2f((m_header.getSize().x - 10) / 2, index * (m_itemSize.y + 10) + 10 + m_itemSize.y / 2.0f);
+}
+void Dropdown::updateRows(bool force)
+{
+	if (!hasModel() || m_updatingRows || m_rows.empty())return;
+
+	// item i spans from i * pitch + 10 to (i + 1) * pitch in the page
+	float pitch = m_itemSize.y + 10;
+	std::size_t first = (std::size_t)(std::max(0.f, m_page.getActiveRegion().top - 10) / pitch);
+	if (!force && first == m_firstItem)return;
+	m_firstItem = first;
 
-	m_itemIDs.erase(m_itemIDs.begin() + where);
+	// rows change the page, which asks this object to redraw
+	m_updatingRows = true;
 
-	--m_itemCount;
+	// each item keeps its row while it stays visible, only rows scrolled out are bound again
+	std::size_t poolSize = m_rows.size();
+	for (std::size_t item = first; item < first + poolSize; item++) {
+		std::size_t k = item % poolSize;
+		TextButton& row = m_rows[k];
 
-	for (int i = where; i < m_itemCount; i++) {
-		m_page.getByID(m_itemIDs[i])->move(0, -m_itemSize.y - 10);
+		if (item >= (std::size_t)m_itemCount) {
+			m_rowItems[k] = noItem;
+			row.setInactive();
+			continue;
+		}
+		if (!force && m_rowItems[k] == item)continue;
+
+		m_rowItems[k] = item;
+		row.setString(m_modelItem(item));
+		row.setPosition(getItemPosition(item));
+		row.setActive();
 	}
 
-	m_page.setMaxSize({ m_header.getSize().x, m_itemCount * (m_itemSize.y + 10) + 10 });
-	m_page.setActiveRegion({ m_page.getActiveRegion().left, m_page.getActiveRegion().top, m_page.getActiveRegion().width, std::min(m_itemLimit, m_itemCount) * (m_itemSize.y + 10) + 10 });
-	m_page.setScroll(Page::ScrollPlacement::RIGHT);
+	m_updatingRows = false;
 }
 void Dropdown::expand()
 {
@@ -264,6 +417,19 @@ bool Dropdown::pollEvents(sf::Event event)
 
 	return false;
 }
+void Dropdown::requestRedraw(const Entity& entity)
+{
+	// scrolled page shows other items of the model
+	if (&entity == &m_page)updateRows(false);
+
+	// header and page are drawn on the functional parent
+	invalidate();
+}
+void Dropdown::detachDestroyed(const Entity& entity)
+{
+	Frame* frame = getFrame();
+	if (frame != nullptr)frame->detachDestroyed(entity);
+}
 bool Dropdown::contains(const sf::Vector2f& point) const
 {
 	return getLocalBounds().contains(getInverseTransform().transformPoint(point));
@@ -295,13 +461,24 @@ Entity* Dropdown::isHit(const sf::Vector2f& point)
 
 	return nullptr;
 }
-void Dropdown::draw(sf::RenderTarget& target, sf::RenderStates states) const
+sf::FloatRect Dropdown::getDrawBounds() const
+{
+	sf::FloatRect bounds;
+
+	if (isActive()) {
+		bounds = uniteRects(m_header.getDrawBounds(), m_minimise.getDrawBounds());
+		if (m_page.isActive())bounds = uniteRects(bounds, m_page.getDrawBounds());
+	}
+
+	return getTransform().transformRect(bounds);
+}
+void Dropdown::submit(RenderBatch& batch, sf::RenderStates states) const
 {
 	if (isActive()) {
 		states.transform *= getTransform();
-		m_header.draw(target, states);
-		m_minimise.draw(target, states);
-		m_page.draw(target, states);
+		m_header.submit(batch, states);
+		m_minimise.submit(batch, states);
+		m_page.submit(batch, states);
 	}
 }
 void Dropdown::activateSelection()
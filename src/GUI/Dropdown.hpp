@@ -5,6 +5,8 @@
 #include "TextButton.hpp"
 #include "Button.hpp"
 #include "Page.hpp"
+#include <deque>
+#include <memory>
 #include <vector>
 
 namespace gui {
@@ -136,6 +138,12 @@ public:
 	////////////////////////////////////////////////////////////
 	sf::Vector2f getHeaderSize() const;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get the state of the mouse sampled by the frame
+	/// 
+	////////////////////////////////////////////////////////////
+	const Pointer& getPointer() const override;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Get the mouse position with respect to the active region of current page
 	/// 
@@ -202,10 +210,30 @@ public:
 	////////////////////////////////////////////////////////////
 	void addItem(Button& button);
 
+	////////////////////////////////////////////////////////////
+	/// \brief add items to the object to the last
+	/// 
+	/// The page and its scroll are fitted once for the whole batch
+	/// 
+	/// \param textboxes -> textbox / TextButton objects to add, in order
+	///
+	////////////////////////////////////////////////////////////
+	void addItems(const std::vector<Textbox*>& textboxes);
+
+	////////////////////////////////////////////////////////////
+	/// \brief add items to the object to the last
+	/// 
+	/// The page and its scroll are fitted once for the whole batch
+	/// 
+	/// \param buttons -> button objects to add, in order
+	///
+	////////////////////////////////////////////////////////////
+	void addItems(const std::vector<Button*>& buttons);
+
 	////////////////////////////////////////////////////////////
 	/// \brief insert an item into the object
 	/// 
-	/// \param where -> index of the item to insert
+	/// \param where -> index of the item to insert, clamped to the first and past the last item
 	/// \param textbox -> textbox / TextButton object to insert
 	///
 	////////////////////////////////////////////////////////////
@@ -214,20 +242,91 @@ public:
 	////////////////////////////////////////////////////////////
 	/// \brief insert an item into the object
 	/// 
-	/// \param where -> index of the item to insert
+	/// \param where -> index of the item to insert, clamped to the first and past the last item
 	/// \param textbox -> button object to insert
 	///
 	////////////////////////////////////////////////////////////
 	void insertItem(int where, Button& button);
 
+	////////////////////////////////////////////////////////////
+	/// \brief insert items into the object
+	/// 
+	/// \param where -> index of the first item to insert, clamped to the first and past the last item
+	/// \param textboxes -> textbox / TextButton objects to insert, in order
+	///
+	////////////////////////////////////////////////////////////
+	void insertItems(int where, const std::vector<Textbox*>& textboxes);
+
+	////////////////////////////////////////////////////////////
+	/// \brief insert items into the object
+	/// 
+	/// \param where -> index of the first item to insert, clamped to the first and past the last item
+	/// \param buttons -> button objects to insert, in order
+	///
+	////////////////////////////////////////////////////////////
+	void insertItems(int where, const std::vector<Button*>& buttons);
+
 	////////////////////////////////////////////////////////////
 	/// \brief erase an item from object
 	/// 
-	/// \param where -> index of the item to erase
+	/// \param where -> index of the item to erase, nothing is erased if out of range
 	///
 	////////////////////////////////////////////////////////////
 	void eraseItem(int where);
 
+	////////////////////////////////////////////////////////////
+	/// \brief erase consecutive items from object
+	/// 
+	/// \param where -> index of the first item to erase, nothing is erased if out of range
+	/// \param count -> number of items to erase, clamped to the last item
+	///
+	////////////////////////////////////////////////////////////
+	void eraseItems(int where, int count);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show the items of a data source instead of attached entities
+	///
+	/// Only the rows visible in the page exist : a pool of item limit + 1
+	/// copies of the style, reused as the page scrolls, so memory and
+	/// per frame cost do not depend on the number of items.
+	/// Items added before are removed, adding an item removes the model.
+	/// 
+	/// \param count -> Returns the number of items
+	/// \param item -> Returns the string of the item at an index
+	/// \param style -> Row copied for every visible item, its size is set by the object
+	///
+	////////////////////////////////////////////////////////////
+	void setModel(std::function<std::size_t()> count, std::function<std::string(std::size_t)> item, const TextButton& style);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the job done when the row of an item of the model is released
+	/// 
+	/// \param action -> Called with the index of the item, can be nullptr
+	///
+	////////////////////////////////////////////////////////////
+	void setModelAction(std::function<void(std::size_t)> action);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Read the number and strings of the items of the model again,
+	///		   to be called whenever the data source changes
+	///
+	////////////////////////////////////////////////////////////
+	void refreshModel();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove the model and its rows
+	///
+	////////////////////////////////////////////////////////////
+	void removeModel();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if the items come from a data source
+	/// 
+	/// \return true if a model is set
+	///
+	////////////////////////////////////////////////////////////
+	bool hasModel() const;
+
 	////////////////////////////////////////////////////////////
 	/// \brief expand dropdown items
 	/// 
@@ -249,6 +348,22 @@ public:
 	////////////////////////////////////////////////////////////
 	bool pollEvents(sf::Event event) override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Notify the object that one of its entities has changed
+	///		   and has to be drawn again
+	/// 
+	/// \param entity -> Entity which has changed
+	/// 
+	////////////////////////////////////////////////////////////
+	void requestRedraw(const Entity& entity) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Forget the header, minimise button or page as they are
+	///		   destroyed if the frame holds them as clicked or hovered
+	///
+	////////////////////////////////////////////////////////////
+	void detachDestroyed(const Entity& entity) override;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Check if the point is inside the object
 	///		   Definition of if the point is inside the object may vary with different gui objects
@@ -282,13 +397,22 @@ public:
 	Entity* isHit(const sf::Vector2f& point) override;
 
 	////////////////////////////////////////////////////////////
-	/// \brief Draws the object to the target applying its states
+	/// \brief Get the rectangle covered by everything the object draws
+	///
+	/// \return Bounding rectangle of the drawn object in the coordinate
+	///			system of the functional parent
+	///
+	////////////////////////////////////////////////////////////
+	sf::FloatRect getDrawBounds() const override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the geometry of the object to the batch applying its states
 	/// 
-	/// \param target -> Render target to draw to
+	/// \param batch -> Batch collecting the geometry
 	/// \param states -> Current render states
 	/// 
 	////////////////////////////////////////////////////////////
-	void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const override;
+	void submit(RenderBatch& batch, sf::RenderStates states = sf::RenderStates::Default) const override;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Actions to take upon selection of the object
@@ -322,13 +446,42 @@ private:
 	////////////////////////////////////////////////////////////
 	void setFunctionalParentForSubVariables(Functional* parent) override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Fit the page and its scroll to the number of items
+	///
+	////////////////////////////////////////////////////////////
+	void resizePage();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Place the items from an index on, by their index
+	///
+	////////////////////////////////////////////////////////////
+	void layoutItems(int from);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the position of an item in the page from its index
+	///
+	////////////////////////////////////////////////////////////
+	sf::Vector2f getItemPosition(std::size_t index) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Bind the rows of the model to the items visible in the page
+	///
+	/// \param force -> true to bind every row again, false to only bind
+	///		   rows whose item has changed since the page scrolled
+	///
+	////////////////////////////////////////////////////////////
+	void updateRows(bool force);
+
+	static const std::size_t noItem = ~std::size_t(0);	/// < item of unused rows
+
 
 	////////////////////////////////////////////////////////////
 	// Member Data
 	////////////////////////////////////////////////////////////
 
 private:
-	std::vector<unsigned int> m_itemIDs;	/// < list of ids of all connected items
+	std::vector<unsigned long long> m_itemIDs;	/// < list of ids of all connected items
 	int m_itemLimit;						/// < limit of items to display at once
 	int m_itemCount;						/// < total number of items
 	sf::Vector2f m_itemSize;				/// < size of one item
@@ -337,6 +490,15 @@ private:
 	Button m_minimise;						/// < minimise button of header
 
 	Page m_page;							/// < page to connect items
+
+	std::function<std::size_t()> m_modelCount;				/// < number of items of the model, empty if items are entities
+	std::function<std::string(std::size_t)> m_modelItem;	/// < string of an item of the model
+	std::function<void(std::size_t)> m_modelAction;			/// < job of a released row, called with its item
+	std::unique_ptr<TextButton> m_rowStyle;					/// < copied by the rows of the model, nullptr without a model
+	std::deque<TextButton> m_rows;							/// < pool of rows, row k shows the items k, k + pool size, ...
+	std::vector<std::size_t> m_rowItems;					/// < item shown by every row, noItem if the row is unused
+	std::size_t m_firstItem;								/// < first visible item at the last updateRows
+	bool m_updatingRows;									/// < whether rows are being bound, their redraw requests are ignored
 };
 
 } // namespace gui
\ No newline at end of file
@@ -6,38 +6,57 @@
 #include "Dropdown.hpp"
 
 #include <iostream>
+#include <cfloat>
+#include <stdexcept>
 
 using namespace gui;
 
-// set the initial count to 0
-unsigned int Entity::item_count = 0;
+// slots of the registry make up for the 24 least significant bits of Ids,
+// the generation of the slot for the next 32 and the class Id for the 8 most significant
+static const unsigned int maxEntityCount = 1u << 24;
+
+static unsigned long long makeID(unsigned int class_id, const Handle& handle)
+{
+	return ((unsigned long long)class_id << 56) | ((unsigned long long)handle.generation << 24) | handle.index;
+}
 
 Entity::Entity(unsigned int class_id)
 {
 	/*
 	* generate unique id
 	* first 8 bits -> class id
-	* last 24 bits item count at the time of construction of entity
+	* next 32 bits -> generation of the slot, an Id is never given twice
+	* last 24 bits -> slot of the entity, reused once the entity is destroyed
 	*/
-	m_id = (class_id << 24) + ++item_count;
+	m_handle = registerEntity(*this);
+	m_id = makeID(class_id, m_handle);
 
 	// set defaults
 	m_selected = false;
+	m_pressed = false;
 	action = nullptr;
 	actionEvent = ActionEvent::NONE;
 	m_active = true;
 	m_functionalParent = nullptr;
+	m_owner = nullptr;
+	m_cachedBoundsValid = false;
 }
 
 Entity::Entity(const Entity& entity)
 {
-	m_id = (getClassID(entity) << 24) + ++item_count;
+	m_handle = registerEntity(*this);
+	m_id = makeID(getClassID(entity), m_handle);
 
 	m_selected = entity.m_selected;
+	m_pressed = entity.m_pressed;
 	action = entity.action;
 	actionEvent = entity.actionEvent;
 	m_active = entity.m_active;
-	m_functionalParent = entity.m_functionalParent;
+	m_owner = nullptr;
+
+	// a copy is not attached, its parent would not know when it is destroyed
+	m_functionalParent = nullptr;
+	m_cachedBoundsValid = false;
 
 	setPosition(entity.getPosition());
 	setScale(entity.getScale());
@@ -48,10 +67,10 @@ Entity::Entity(const Entity& entity)
 Entity& Entity::operator=(const Entity& entity)
 {
 	m_selected = entity.m_selected;
+	m_pressed = entity.m_pressed;
 	action = entity.action;
 	actionEvent = entity.actionEvent;
 	m_active = entity.m_active;
-	m_functionalParent = entity.m_functionalParent;
 
 	setPosition(entity.getPosition());
 	setScale(entity.getScale());
@@ -64,32 +83,183 @@ Entity& Entity::operator=(const Entity& entity)
 
 Entity::~Entity()
 {
+	// only the parent holding the entity is told, nothing is scanned
+	if (m_functionalParent != nullptr)m_functionalParent->detachDestroyed(*this);
 
+	// invalidates every handle of the entity, names included
+	registry().remove(m_handle);
 }
-unsigned int Entity::getID() const
+unsigned long long Entity::getID() const
 {
 	return m_id;
 }
 unsigned int Entity::getClassID(const Entity& entity)
 {
 	// get the 8 most significan bits
-	return entity.getID() >> 24;
+	return (unsigned int)(entity.getID() >> 56);
+}
+Handle Entity::getHandle() const
+{
+	return m_handle;
+}
+Entity* Entity::get(const Handle& handle)
+{
+	Entity** entity = registry().get(handle);
+	return entity != nullptr ? *entity : nullptr;
+}
+std::size_t Entity::getLiveCount()
+{
+	return registry().getSize();
+}
+unsigned long long Entity::getDestroyedCount()
+{
+	return registry().getRemovalCount();
+}
+SlotMap<Entity*>& Entity::registry()
+{
+	// constructed on first use, entities may be globals of other files
+	static SlotMap<Entity*> entities;
+	return entities;
+}
+Handle Entity::registerEntity(Entity& entity)
+{
+	Handle handle = registry().insert(&entity);
+	if (handle.index >= maxEntityCount) {
+		registry().remove(handle);
+		throw std::length_error("gui::Entity : too many live entities");
+	}
+	return handle;
 }
 Functional* gui::Entity::getFunctionalParent() const
 {
 	return m_functionalParent;
 }
+Animator* Entity::getAnimator() const
+{
+	Frame* frame = m_functionalParent != nullptr ? m_functionalParent->getFrame() : nullptr;
+	return frame != nullptr ? &frame->getAnimator() : nullptr;
+}
 bool gui::Entity::isSelected() const
 {
 	return m_selected;
 }
+bool Entity::isPressed() const
+{
+	return m_pressed;
+}
+void Entity::activatePress()
+{
+	m_pressed = true;
+}
+void Entity::deactivatePress()
+{
+	m_pressed = false;
+}
+void Entity::setPosition(float x, float y)
+{
+	sf::Transformable::setPosition(x, y);
+	invalidate();
+}
+void Entity::setPosition(const sf::Vector2f& position)
+{
+	sf::Transformable::setPosition(position);
+	invalidate();
+}
+void Entity::setRotation(float angle)
+{
+	sf::Transformable::setRotation(angle);
+	invalidate();
+}
+void Entity::setScale(float factorX, float factorY)
+{
+	sf::Transformable::setScale(factorX, factorY);
+	invalidate();
+}
+void Entity::setScale(const sf::Vector2f& factors)
+{
+	sf::Transformable::setScale(factors);
+	invalidate();
+}
+void Entity::setOrigin(float x, float y)
+{
+	sf::Transformable::setOrigin(x, y);
+	invalidate();
+}
+void Entity::setOrigin(const sf::Vector2f& origin)
+{
+	sf::Transformable::setOrigin(origin);
+	invalidate();
+}
+void Entity::move(float offsetX, float offsetY)
+{
+	sf::Transformable::move(offsetX, offsetY);
+	invalidate();
+}
+void Entity::move(const sf::Vector2f& offset)
+{
+	sf::Transformable::move(offset);
+	invalidate();
+}
+void Entity::rotate(float angle)
+{
+	sf::Transformable::rotate(angle);
+	invalidate();
+}
+void Entity::scale(float factorX, float factorY)
+{
+	sf::Transformable::scale(factorX, factorY);
+	invalidate();
+}
+void Entity::scale(const sf::Vector2f& factor)
+{
+	sf::Transformable::scale(factor);
+	invalidate();
+}
+void Entity::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	RenderBatch batch(target);
+	submit(batch, states);
+	batch.flush();
+}
+void Entity::invalidate()
+{
+	m_cachedBoundsValid = false;
+
+	// parts of another entity are redrawn with their owner
+	if (m_owner != nullptr)
+		m_owner->invalidate();
+	else if (m_functionalParent != nullptr)
+		m_functionalParent->requestRedraw(*this);
+}
+const sf::FloatRect& Entity::getCachedDrawBounds() const
+{
+	if (!m_cachedBoundsValid) {
+		m_cachedBounds = getDrawBounds();
+		m_cachedBoundsValid = true;
+	}
+	return m_cachedBounds;
+}
+sf::FloatRect Entity::uniteRects(const sf::FloatRect& first, const sf::FloatRect& second)
+{
+	if (first.width <= 0 || first.height <= 0)return second;
+	if (second.width <= 0 || second.height <= 0)return first;
+
+	float left = std::min(first.left, second.left);
+	float top = std::min(first.top, second.top);
+	float right = std::max(first.left + first.width, second.left + second.width);
+	float bottom = std::max(first.top + first.height, second.top + second.height);
+
+	return sf::FloatRect(left, top, right - left, bottom - top);
+}
 void Entity::setActive()
 {
 	m_active = true;
+	invalidate();
 }
 void Entity::setInactive()
 {
 	m_active = false;
+	invalidate();
 }
 bool Entity::isActive() const
 {
@@ -121,41 +291,92 @@ void gui::setFunctionalParent(Entity& entity, Functional* parent)
 	entity.setFunctionalParentForSubVariables(parent);
 }
 
+void gui::setOwner(Entity& entity, Entity* owner)
+{
+	entity.m_owner = owner;
+}
+
 
-std::unordered_map<std::string, unsigned int> Frame::m_nameMap;
+const std::size_t Frame::noSlot;
 
 Frame::Frame()
 {
 	// set defaults
-	m_window = nullptr;
+	m_target = nullptr;
+	m_input = nullptr;
 	m_mouseHoveringOn = nullptr;
 	m_clicked = nullptr;
+	m_clearColor = sf::Color::Black;
+	m_fullRedraw = true;
+	m_themeChangeCount = Theme::getChangeCount();
+	m_damagedPixelCount = 0;
+	m_redrawnEntityCount = 0;
+	m_tombstoneCount = 0;
+	m_nextOrder = 0;
+	m_pointer = { sf::Vector2f(), sf::Vector2f(), 0, sf::Time::Zero };
+	m_sceneChanged = true;
 
 	m_functional_object = FunctionalObject::FRAME;
 }
 Frame::~Frame()
 {
-
+	// entities outliving the frame must not report their destruction to it
+	for (const DisplayItem& item : m_displayList) {
+		if (item.entity != nullptr)setFunctionalParent(*item.entity, nullptr);
+	}
 }
 
 void Frame::setWindow(sf::RenderWindow& window)
 {
-	m_window = &window;
+	m_target = &window;
+	m_settings = window.getSettings();
+	m_windowInput.setWindow(window);
+	m_input = &m_windowInput;
+	m_fullRedraw = true;
+}
+
+void Frame::setRenderTarget(sf::RenderTarget& target)
+{
+	m_target = &target;
+	m_settings = sf::ContextSettings();
+	m_fullRedraw = true;
+}
+
+void Frame::setInputSource(InputSource& input)
+{
+	m_input = &input;
+	m_sceneChanged = true;
+}
+
+InputSource* Frame::getInputSource() const
+{
+	return m_input;
 }
 
 void Frame::addEntity(Entity& entity)
 {
-	// insert in map
-	m_entityMap.insert(std::make_pair(entity.getID(), &entity));
+	// insert on top of the display list
+	if (findSlot(entity.getID()) == noSlot) {
+		DisplayItem item = { &entity, nullptr, entity.getID(), entity.getHandle() };
 
-	if(Entity::getClassID(entity) == GUI_ID_PAGE){
-		m_functionalParents.insert(std::make_pair(entity.getID(), (Functional*)((Page*)(&entity))));
-	}
-	if(Entity::getClassID(entity) == GUI_ID_DROPDOWN){
-		m_functionalParents.insert(std::make_pair(entity.getID(), (Functional*)((Dropdown*)(&entity))));
+		if(Entity::getClassID(entity) == GUI_ID_PAGE){
+			item.functional = (Functional*)((Page*)(&entity));
+		}
+		if(Entity::getClassID(entity) == GUI_ID_DROPDOWN){
+			item.functional = (Functional*)((Dropdown*)(&entity));
+		}
+
+		if (entity.getHandle().index >= m_displaySlots.size())m_displaySlots.resize(entity.getHandle().index + 1, noSlot);
+		m_displaySlots[entity.getHandle().index] = m_displayList.size();
+		m_displayList.push_back(item);
+		m_grid.insert(entity, m_nextOrder++);
 	}
 	
 	setFunctionalParent(entity, this);
+
+	// new entity has to be drawn
+	m_dirtyEntities.insert(entity.getID());
+	m_sceneChanged = true;
 }
 
 void Frame::removeEntity(Entity& entity)
@@ -164,55 +385,174 @@ void Frame::removeEntity(Entity& entity)
 	//setEntityFrame(entity, nullptr);
 
 	// if entity's name exists remove it
-	std::string name = getName(entity.getID());
-	if (name != "")removeName(name);
+	removeName(entity);
 
-	// erase entity from map
-	m_entityMap.erase(entity.getID());
+	removeEntity(entity.getID());
 }
 
-void Frame::removeEntity(unsigned int id)
+void Frame::removeEntity(unsigned long long id)
 {
-	m_entityMap.erase(id);
+	// a removed entity no longer reports to the frame
+	Entity* entity = getByID(id);
+	if (entity != nullptr && entity->getFunctionalParent() == this)setFunctionalParent(*entity, nullptr);
+
+	detach(id);
+	compactDisplayList();
 }
 
-void Frame::setName(const Entity& entity, const std::string& name)
+void Frame::detach(unsigned long long id)
 {
-	m_nameMap[name] = entity.getID();
+	// region covered by entity has to be drawn again
+	auto bounds = m_drawnBounds.find(id);
+	if (bounds != m_drawnBounds.end()) {
+		m_removedBounds.push_back(bounds->second);
+		m_drawnBounds.erase(bounds);
+	}
+	m_dirtyEntities.erase(id);
+	m_sceneChanged = true;
+
+	// leave a tombstone so other slots stay valid
+	std::size_t slot = findSlot(id);
+	if (slot != noSlot) {
+		m_displaySlots[m_displayList[slot].handle.index] = noSlot;
+		m_displayList[slot] = { nullptr, nullptr, 0, Handle() };
+		m_tombstoneCount++;
+		m_grid.remove(id);
+	}
 }
 
-void Frame::removeName(const std::string& name)
+void Frame::raiseToFront(Entity& entity)
 {
-	m_nameMap.erase(name);
+	raiseToFront(entity.getID());
 }
 
-Entity* Frame::getByID(unsigned int id) const
+void Frame::raiseToFront(unsigned long long id)
 {
-	return m_entityMap.at(id);
+	std::size_t slot = findSlot(id);
+	if (slot == noSlot || slot + 1 == m_displayList.size())return;
+
+	// move to a new slot on top, old slot becomes a tombstone
+	DisplayItem item = m_displayList[slot];
+	m_displayList[slot] = { nullptr, nullptr, 0, Handle() };
+	m_tombstoneCount++;
+
+	m_displaySlots[item.handle.index] = m_displayList.size();
+	m_displayList.push_back(item);
+	m_grid.setOrder(id, m_nextOrder++);
+
+	// entities overlapping the raised entity have to be drawn again in the new order
+	m_dirtyEntities.insert(id);
+	m_sceneChanged = true;
+
+	compactDisplayList();
 }
 
-Entity* Frame::getByName(const std::string& name) const
+void Frame::compactDisplayList()
 {
-	return m_entityMap.at(m_nameMap.at(name));
+	if (m_tombstoneCount * 2 <= m_displayList.size())return;
+
+	std::size_t size = 0;
+	for (std::size_t i = 0; i < m_displayList.size(); i++) {
+		if (m_displayList[i].entity == nullptr)continue;
+
+		m_displayList[size] = m_displayList[i];
+		m_displaySlots[m_displayList[size].handle.index] = size;
+		size++;
+	}
+	m_displayList.resize(size);
+	m_tombstoneCount = 0;
 }
-unsigned int Frame::getIDByName(const std::string& name)
+
+std::size_t Frame::findSlot(unsigned long long id) const
 {
-	return m_nameMap.at(name);
+	// Ids and handles of live entities share their slot in the registry
+	unsigned int index = (unsigned int)(id & 0xffffff);
+	if (index >= m_displaySlots.size())return noSlot;
+
+	std::size_t slot = m_displaySlots[index];
+	if (slot == noSlot || m_displayList[slot].id != id)return noSlot;
+	return slot;
 }
-std::string Frame::getName(unsigned int id)
+
+void Frame::detachDestroyed(const Entity& entity)
 {
-	for (auto it = m_nameMap.begin(); it != m_nameMap.end(); it++) {
-		if (it->second == id)return it->first;
+	if (m_clicked == &entity)m_clicked = nullptr;
+	if (m_mouseHoveringOn == &entity) {
+		m_mouseHoveringOn = nullptr;
+		m_sceneChanged = true;
 	}
-	return "";
+	m_names.remove(entity.getID());
+
+	// area of destroyed entities is damaged like that of removed ones
+	if (findSlot(entity.getID()) == noSlot)return;
+	detach(entity.getID());
+	compactDisplayList();
+}
+
+void Frame::setName(const Entity& entity, const Name& name)
+{
+	m_names.set(entity, name);
+}
+
+void Frame::removeName(const Name& name)
+{
+	m_names.remove(name);
+}
+
+void Frame::removeName(const Entity& entity)
+{
+	m_names.remove(entity.getID());
+}
+
+Entity* Frame::getByID(unsigned long long id) const
+{
+	std::size_t slot = findSlot(id);
+	return slot != noSlot ? Entity::get(m_displayList[slot].handle) : nullptr;
+}
+
+Entity* Frame::getByHandle(const Handle& handle) const
+{
+	std::size_t slot = handle.index < m_displaySlots.size() ? m_displaySlots[handle.index] : noSlot;
+	return slot != noSlot && m_displayList[slot].handle == handle ? Entity::get(handle) : nullptr;
+}
+
+Entity* Frame::getByName(const Name& name) const
+{
+	return getByID(m_names.getID(name));
+}
+unsigned long long Frame::getIDByName(const Name& name) const
+{
+	return m_names.getID(name);
+}
+const std::string& Frame::getName(unsigned long long id) const
+{
+	return m_names.getName(id);
+}
+const Pointer& Frame::getPointer() const
+{
+	return m_pointer;
 }
 sf::Vector2f Frame::getMousePosition() const
 {
-	return m_window->mapPixelToCoords(sf::Mouse::getPosition(*m_window));
+	return m_pointer.position;
 }
 sf::Vector2f Frame::getLastMouseOffset() const
 {
-	return getMousePosition() - m_lastMousePos;
+	return m_pointer.delta;
+}
+void Frame::samplePointer()
+{
+	m_pointer.buttons = 0;
+	for (int i = 0; i < sf::Mouse::ButtonCount; i++) {
+		if (m_input->isButtonPressed(sf::Mouse::Button(i)))m_pointer.buttons |= 1u << i;
+	}
+	movePointer(m_input->getMousePosition());
+}
+void Frame::movePointer(const sf::Vector2i& pixel)
+{
+	m_pointer.position = m_target != nullptr ? m_target->mapPixelToCoords(pixel) : sf::Vector2f(pixel);
+	m_pointer.delta = m_pointer.position - m_lastMousePos;
+	if (m_input != nullptr)m_pointer.timestamp = m_input->getTime();
 }
 bool Frame::contains(const sf::Vector2f& point) const
 {
@@ -220,24 +560,41 @@ bool Frame::contains(const sf::Vector2f& point) const
 }
 sf::FloatRect Frame::getLocalBounds() const
 {
-	return sf::FloatRect(0, 0, m_window->getSize().x, m_window->getSize().y);
+	// without target, frame is unbounded
+	if (m_target == nullptr)return sf::FloatRect(-FLT_MAX / 2, -FLT_MAX / 2, FLT_MAX, FLT_MAX);
+
+	return sf::FloatRect(0, 0, m_target->getSize().x, m_target->getSize().y);
 }
 void Frame::update()
 {
+	GUI_TRACE_SCOPE("Frame::update");
+	GUI_TRACK_PHASE(UPDATE);
+
+	// animated entities move before the mouse is tested against them
+	if (m_input != nullptr) {
+		GUI_PROFILE_SCOPE(m_profiler, ANIMATION);
+		m_animator.update(m_input->getTime());
+	}
+
 	// only work if window has focus
-	if (m_window->hasFocus()) {
+	if (m_input != nullptr && m_input->hasFocus()) {
+		// mouse is read from the system once per update
+		samplePointer();
+
 		// only work if mouse is inside the window
 		if(!contains(getMousePosition())){
 			if (m_mouseHoveringOn != nullptr)m_mouseHoveringOn->deactivateSelection();
+			if (m_clicked != nullptr)m_clicked->deactivatePress();
 			m_mouseHoveringOn = nullptr;
 			m_clicked = nullptr;
+			m_sceneChanged = true;
 		}
 		else {
 			// if mouse is moved while being held on something
 			if (m_clicked != nullptr && m_clicked->actionEvent == Entity::ActionEvent::MOUSEHELD && m_clicked->hasAction()) {
 				// if functional parent is frame or nullptr then object does not depend bounds (control by other entities) 
 				if(m_clicked->getFunctionalParent() == nullptr ||  m_clicked->getFunctionalParent()->getFunctionalFrame() == FunctionalObject::FRAME) {
-					m_clicked->callAction();
+					callAction(*m_clicked);
 				}
 				// if functional parent is page then its bounds are decided by the local bounds visible on the functional parent of its functional parent
 				else if(m_clicked->getFunctionalParent()->getFunctionalFrame() == FunctionalObject::PAGE &&
@@ -246,7 +603,7 @@ void Frame::update()
 							((Page*)(m_clicked->getFunctionalParent()))->getFunctionalParent()->getMousePosition()
 						)
 					))
-					m_clicked->callAction();
+					callAction(*m_clicked);
 				// if functional parent is dropdown then its bounds are decided by the local bounds visible on the functional parent of its functional parent
 				else if (m_clicked->getFunctionalParent()->getFunctionalFrame() == FunctionalObject::DROPDOWN &&
 					m_clicked->getFunctionalParent()->getLocalBounds().contains(
@@ -254,24 +611,40 @@ void Frame::update()
 							((Dropdown*)(m_clicked->getFunctionalParent()))->getFunctionalParent()->getMousePosition()
 						)
 					))
-					m_clicked->callAction();
+					callAction(*m_clicked);
 				// if out of bounds
 				else {
 					m_mouseHoveringOn->deactivateSelection();
+					m_clicked->deactivatePress();
 					m_clicked = nullptr;
 					m_mouseHoveringOn = nullptr;
+					m_sceneChanged = true;
 				}
 			}
 			else {
-				// search through all entities if mouse is in window
-				Entity* currentMouseHoveringOn = nullptr;
-				for (auto it = m_entityMap.begin(); it != m_entityMap.end() && currentMouseHoveringOn == nullptr; it++) {
-					currentMouseHoveringOn = it->second->isHit(getMousePosition());
+				// same entity is hit if neither the mouse nor any entity has changed
+				Entity* currentMouseHoveringOn = m_mouseHoveringOn;
+				if (m_sceneChanged || m_hitPosition != getMousePosition()) {
+					// search front to back through entities whose bounds contain the mouse
+					GUI_PROFILE_SCOPE(m_profiler, HIT_TEST);
+					currentMouseHoveringOn = nullptr;
+					m_grid.query(getMousePosition(), m_found);
+					for (auto it = m_found.rbegin(); it != m_found.rend() && currentMouseHoveringOn == nullptr; it++) {
+						GUI_PROFILE_VISIT(m_profiler, 1);
+						GUI_TRACK_CLASS(**it);
+						currentMouseHoveringOn = (*it)->isHit(getMousePosition());
+					}
+					m_hitPosition = getMousePosition();
+					m_sceneChanged = false;
 				}
 
 				//if entity has action event as mouse hover
-				if (currentMouseHoveringOn != nullptr && currentMouseHoveringOn->actionEvent == Entity::ActionEvent::MOUSEHOVER && currentMouseHoveringOn->hasAction())
+				if (currentMouseHoveringOn != nullptr && currentMouseHoveringOn->actionEvent == Entity::ActionEvent::MOUSEHOVER && currentMouseHoveringOn->hasAction()) {
+					GUI_PROFILE_SCOPE(m_profiler, ACTION);
+					GUI_TRACE_ENTITY("callAction", *currentMouseHoveringOn);
+					GUI_TRACK_CLASS(*currentMouseHoveringOn);
 					currentMouseHoveringOn->action();
+				}
 
 				// if mouse leaves previously pointed entity
 				if (m_mouseHoveringOn != currentMouseHoveringOn)
@@ -280,6 +653,7 @@ void Frame::update()
 						m_mouseHoveringOn->deactivateSelection();
 					}
 					m_mouseHoveringOn = currentMouseHoveringOn;
+					m_hoverHandle = m_mouseHoveringOn != nullptr ? m_mouseHoveringOn->getHandle() : Handle();
 
 					if (m_mouseHoveringOn != nullptr) {
 						m_mouseHoveringOn->activateSelection();
@@ -290,15 +664,52 @@ void Frame::update()
 		//update last mouse pos
 		m_lastMousePos = getMousePosition();
 	}
+
+	if (m_input != nullptr)m_input->nextFrame();
+}
+unsigned int Frame::pollInputEvents()
+{
+	if (m_input == nullptr)return 0;
+
+	unsigned int count = 0;
+	sf::Event event;
+	while (m_input->pollEvent(event)) {
+		pollEvents(event);
+		count++;
+	}
+	return count;
 }
 bool Frame::pollEvents(sf::Event e)
 {
+	GUI_PROFILE_SCOPE(m_profiler, DISPATCH);
+	GUI_TRACK_PHASE(EVENTS);
+
+	// mouse events carry their own position
+	if (e.type == sf::Event::MouseButtonPressed || e.type == sf::Event::MouseButtonReleased)
+		movePointer(sf::Vector2i(e.mouseButton.x, e.mouseButton.y));
+	else if (e.type == sf::Event::MouseWheelScrolled)
+		movePointer(sf::Vector2i(e.mouseWheelScroll.x, e.mouseWheelScroll.y));
+
 	// if an entity is clicked
 	if (e.type == sf::Event::MouseButtonPressed && e.mouseButton.button == sf::Mouse::Left) {
 		m_clicked = m_mouseHoveringOn;
+		m_clickedHandle = m_hoverHandle;
+		if (m_clicked != nullptr)m_clicked->activatePress();
+
+		// bring pressed top level page or dropdown to front
+		if (m_clicked != nullptr) {
+			m_grid.query(getMousePosition(), m_found);
+			for (auto it = m_found.rbegin(); it != m_found.rend(); it++) {
+				if ((*it)->isHit(getMousePosition()) == m_clicked) {
+					unsigned int classID = Entity::getClassID(**it);
+					if (classID == GUI_ID_PAGE || classID == GUI_ID_DROPDOWN)raiseToFront(**it);
+					break;
+				}
+			}
+		}
 
 		if (m_clicked != nullptr && m_clicked->actionEvent == Entity::ActionEvent::PRESS && m_clicked->hasAction())
-			m_clicked->callAction();
+			callAction(*m_clicked);
 
 		return true;
 	}
@@ -307,8 +718,10 @@ bool Frame::pollEvents(sf::Event e)
 		if (m_clicked != nullptr && m_clicked == m_mouseHoveringOn && e.mouseButton.button == sf::Mouse::Left)
 		{
 			if (m_clicked->actionEvent == Entity::ActionEvent::RELEASE && m_clicked->hasAction())
-				m_clicked->callAction();
+				callAction(*m_clicked);
 		}
+		if (m_clicked != nullptr)m_clicked->deactivatePress();
+
 		// textboxes whose input is enabled dont lose thier click unless something else is clicked
 		if(m_clicked != nullptr && (Entity::getClassID(*m_clicked) != GUI_ID_TEXTBOX || !((Textbox*)m_clicked)->isInputEnabled()))
 			m_clicked = nullptr;
@@ -318,15 +731,18 @@ bool Frame::pollEvents(sf::Event e)
 	// if mouse wheel is scrolled while mouse is over a page or dropdown
 	else if (e.type == sf::Event::MouseWheelScrolled) {
 		bool wasEventPolled = false;
-		// poll events in pages and dropdowns
-		for (auto it = m_functionalParents.begin(); it != m_functionalParents.end() && !wasEventPolled; it++) {
-			if (it->second->getFunctionalFrame() != 0 && it->second->contains(getMousePosition()))
-				wasEventPolled = it->second->pollEvents(e);
+		// poll events in pages and dropdowns front to back
+		for (auto it = m_displayList.rbegin(); it != m_displayList.rend() && !wasEventPolled; it++) {
+			if (it->functional != nullptr && it->functional->getFunctionalFrame() != 0 && it->functional->contains(getMousePosition())) {
+				GUI_TRACK_CLASS(*it->entity);
+				wasEventPolled = it->functional->pollEvents(e);
+			}
 		}
 	}
 	// if text is entered while textbox is seleccted
 	else if (m_clicked != nullptr && Entity::getClassID(*m_clicked) == GUI_ID_TEXTBOX && ((Textbox*)m_clicked)->isInputEnabled() && e.type == sf::Event::TextEntered) {
 		Textbox& textbox = *((Textbox*)m_clicked);
+		GUI_TRACK_CLASS(textbox);
 		char c = e.text.unicode;
 		if (c == 13) { // enter is pressed
 			if (textbox.isNewLineEnabled())textbox.setString(textbox.getString() + '\n');
@@ -344,14 +760,303 @@ bool Frame::pollEvents(sf::Event e)
 
 	return false;
 }
+void Frame::requestRedraw(const Entity& entity)
+{
+	// removed entities may still report changes
+	if (findSlot(entity.getID()) != noSlot) {
+		m_dirtyEntities.insert(entity.getID());
+		m_grid.invalidate(entity.getID());
+		m_sceneChanged = true;
+	}
+}
+void Frame::setClearColor(const sf::Color& color)
+{
+	m_clearColor = color;
+	m_fullRedraw = true;
+}
+unsigned int Frame::getDamagedPixelCount() const
+{
+	return m_damagedPixelCount;
+}
+unsigned int Frame::getRedrawnEntityCount() const
+{
+	return m_redrawnEntityCount;
+}
+unsigned int Frame::getDrawCallCount() const
+{
+	return m_batch.getDrawCallCount();
+}
+const RenderBatch::Stats& Frame::getRenderStats() const
+{
+	return m_batch.getStats();
+}
+RenderBatch::Stats Frame::getRenderStats(unsigned long long id) const
+{
+	return m_batch.getStats(id);
+}
+bool Frame::hasPendingRedraw() const
+{
+	if (m_target == nullptr)return false;
+
+	return m_fullRedraw || !m_dirtyEntities.empty() || !m_removedBounds.empty() ||
+		m_backbuffer.getSize() != m_target->getSize() || hasViewChanged();
+}
+bool Frame::isIdle() const
+{
+	if (hasPendingRedraw() || m_animator.isRunning())return false;
+
+	// clicked and hovered entities are forgotten as they are destroyed
+	const Entity* clicked = m_clicked != nullptr ? Entity::get(m_clickedHandle) : nullptr;
+	const Entity* hovered = m_mouseHoveringOn != nullptr ? Entity::get(m_hoverHandle) : nullptr;
+
+	// mouse held actions are called every update while the button is down
+	if (clicked != nullptr && clicked->actionEvent == Entity::ActionEvent::MOUSEHELD && clicked->hasAction())
+		return false;
+
+	// mouse hover actions are called every update while the mouse is over the entity
+	if (hovered != nullptr && hovered->actionEvent == Entity::ActionEvent::MOUSEHOVER && hovered->hasAction())
+		return false;
+
+	return true;
+}
+Animator& Frame::getAnimator()
+{
+	return m_animator;
+}
+sf::IntRect Frame::mapRectToPixels(const sf::FloatRect& rect) const
+{
+	// map every corner since view might be rotated
+	sf::Vector2i corners[4] = {
+		m_target->mapCoordsToPixel({ rect.left, rect.top }),
+		m_target->mapCoordsToPixel({ rect.left + rect.width, rect.top }),
+		m_target->mapCoordsToPixel({ rect.left + rect.width, rect.top + rect.height }),
+		m_target->mapCoordsToPixel({ rect.left, rect.top + rect.height })
+	};
+
+	sf::Vector2i min = corners[0], max = corners[0];
+	for (int i = 1; i < 4; i++) {
+		min.x = std::min(min.x, corners[i].x);
+		min.y = std::min(min.y, corners[i].y);
+		max.x = std::max(max.x, corners[i].x);
+		max.y = std::max(max.y, corners[i].y);
+	}
+
+	// padding for antialiased edges and rounding
+	min -= sf::Vector2i(2, 2);
+	max += sf::Vector2i(2, 2);
+
+	// clamp to the window
+	sf::Vector2i size(m_target->getSize());
+	min.x = std::max(min.x, 0);
+	min.y = std::max(min.y, 0);
+	max.x = std::min(max.x, size.x);
+	max.y = std::min(max.y, size.y);
+
+	if (max.x <= min.x || max.y <= min.y)return sf::IntRect();
+
+	return sf::IntRect(min, max - min);
+}
+bool Frame::hasViewChanged() const
+{
+	const sf::View& view = m_target->getView();
+
+	return view.getCenter() != m_lastView.getCenter() ||
+		view.getSize() != m_lastView.getSize() ||
+		view.getRotation() != m_lastView.getRotation() ||
+		view.getViewport() != m_lastView.getViewport();
+}
 void Frame::draw()
 {
-	for (auto it = m_entityMap.begin(); it != m_entityMap.end(); it++) {
-		it->second->draw(*m_window);
+	// profiler frame ends after the draw phase
+	GUI_PROFILE_FRAME(m_profiler);
+	GUI_PROFILE_SCOPE(m_profiler, DRAW);
+	GUI_TRACE_SCOPE("Frame::draw");
+	GUI_TRACK_PHASE(DRAW);
+
+	m_damagedPixelCount = 0;
+	m_redrawnEntityCount = 0;
+	m_batch.resetStats();
+
+	if (m_target == nullptr)return;
+
+	sf::Vector2u size = m_target->getSize();
+
+	// backbuffer is recreated with the window, then everything is damaged
+	if (m_backbuffer.getSize() != size) {
+		m_backbuffer.create(size.x, size.y, m_settings);
+		m_batch.countSurface();
+		m_fullRedraw = true;
+	}
+	// changed view moves every entity on the window
+	if (hasViewChanged()) {
+		m_lastView = m_target->getView();
+		m_fullRedraw = true;
+	}
+	// a swapped theme restyles widgets anywhere on the window
+	if (m_themeChangeCount != Theme::getChangeCount()) {
+		m_themeChangeCount = Theme::getChangeCount();
+		m_fullRedraw = true;
+	}
+
+	/*
+		collect damage :
+			full redraw -> whole window
+			removed entity -> last drawn bounds
+			changed entity -> last drawn bounds and current bounds
+	*/
+	m_damage.clear();
+	if (m_fullRedraw) {
+		for (auto it = m_displayList.begin(); it != m_displayList.end(); it++)
+			if (it->entity != nullptr)m_drawnBounds[it->entity->getID()] = it->entity->getDrawBounds();
+
+		m_damage.push_back(sf::IntRect(0, 0, size.x, size.y));
+	}
+	else {
+		for (auto it = m_removedBounds.begin(); it != m_removedBounds.end(); it++)
+			m_damage.push_back(mapRectToPixels(*it));
+
+		for (auto it = m_dirtyEntities.begin(); it != m_dirtyEntities.end(); it++) {
+			auto bounds = m_drawnBounds.find(*it);
+			if (bounds != m_drawnBounds.end())m_damage.push_back(mapRectToPixels(bounds->second));
+
+			sf::FloatRect newBounds = getByID(*it)->getDrawBounds();
+			m_drawnBounds[*it] = newBounds;
+			m_damage.push_back(mapRectToPixels(newBounds));
+		}
+	}
+	m_fullRedraw = false;
+	m_removedBounds.clear();
+	m_dirtyEntities.clear();
+
+	// merge overlapping rectangles so no pixel is drawn twice
+	for (std::size_t i = 0; i < m_damage.size(); i++) {
+		if (m_damage[i].width <= 0 || m_damage[i].height <= 0) {
+			m_damage.erase(m_damage.begin() + i--);
+			continue;
+		}
+		for (std::size_t j = 0; j < i; j++) {
+			if (m_damage[i].intersects(m_damage[j])) {
+				int left = std::min(m_damage[i].left, m_damage[j].left);
+				int top = std::min(m_damage[i].top, m_damage[j].top);
+				int right = std::max(m_damage[i].left + m_damage[i].width, m_damage[j].left + m_damage[j].width);
+				int bottom = std::max(m_damage[i].top + m_damage[i].height, m_damage[j].top + m_damage[j].height);
+
+				// merged rectangle may overlap earlier ones, check it again
+				m_damage[j] = sf::IntRect(left, top, right - left, bottom - top);
+				m_damage.erase(m_damage.begin() + i);
+				i = j - 1;
+				break;
+			}
+		}
+	}
+
+	// redraw damaged regions over the retained backbuffer
+	m_batch.pushTarget(m_backbuffer);
+	const sf::View& view = m_target->getView();
+	sf::Vector2f viewport(view.getViewport().width * size.x, view.getViewport().height * size.y);
+	for (auto rect = m_damage.begin(); rect != m_damage.end(); rect++) {
+		m_damagedPixelCount += rect->width * rect->height;
+
+		sf::FloatRect fraction(
+			(float)rect->left / size.x, (float)rect->top / size.y,
+			(float)rect->width / size.x, (float)rect->height / size.y
+		);
+
+		// pending geometry belongs to the previous region
+		m_batch.flush();
+
+		// clear region, BlendNone replaces old pixels with the premultiplied clear color
+		sf::View pixelView(sf::FloatRect(rect->left, rect->top, rect->width, rect->height));
+		pixelView.setViewport(fraction);
+		m_backbuffer.setView(pixelView);
+
+		sf::RectangleShape clearRect(sf::Vector2f(rect->width, rect->height));
+		clearRect.setPosition(rect->left, rect->top);
+		clearRect.setFillColor(sf::Color(
+			(sf::Uint8)(m_clearColor.r * m_clearColor.a / 255), (sf::Uint8)(m_clearColor.g * m_clearColor.a / 255),
+			(sf::Uint8)(m_clearColor.b * m_clearColor.a / 255), m_clearColor.a
+		));
+		m_batch.draw(clearRect, sf::BlendNone);
+
+		// clip the view of the window to the region
+		sf::Vector2f center(rect->left + rect->width * 0.5f, rect->top + rect->height * 0.5f);
+		sf::Vector2f ndc(
+			-1.f + 2.f * (center.x - view.getViewport().left * size.x) / viewport.x,
+			1.f - 2.f * (center.y - view.getViewport().top * size.y) / viewport.y
+		);
+		sf::View clipView(view);
+		clipView.setCenter(view.getInverseTransform().transformPoint(ndc));
+		clipView.setSize(view.getSize().x * rect->width / viewport.x, view.getSize().y * rect->height / viewport.y);
+		clipView.setViewport(fraction);
+		m_batch.flush();
+		m_backbuffer.setView(clipView);
+
+		// draw entities overlapping the region back to front
+		for (auto it = m_displayList.begin(); it != m_displayList.end(); it++) {
+			if (it->entity != nullptr && mapRectToPixels(m_drawnBounds[it->entity->getID()]).intersects(*rect)) {
+				GUI_TRACE_ENTITY("draw", *it->entity);
+				RenderBatch::EntityScope scope(m_batch, it->entity->getID());
+				GUI_TRACK_CLASS(*it->entity);
+				it->entity->submit(m_batch);
+				m_redrawnEntityCount++;
+				GUI_PROFILE_VISIT(m_profiler, 1);
+			}
+		}
 	}
+	m_batch.popTarget();
+	m_backbuffer.display();
+	GUI_PROFILE_DRAW_CALLS(m_profiler, m_batch.getDrawCallCount());
+
+	// copy the viewport of the backbuffer to the window pixel by pixel, what the application
+	// drew shows through where the clear color and the entities are not opaque
+	sf::IntRect area(
+		(int)(m_lastView.getViewport().left * size.x), (int)(m_lastView.getViewport().top * size.y),
+		(int)viewport.x, (int)viewport.y
+	);
+	sf::Sprite sprite(m_backbuffer.getTexture(), area);
+	sprite.setPosition((float)area.left, (float)area.top);
+	m_target->setView(m_target->getDefaultView());
+	m_target->draw(sprite, RenderBatch::BlendPremultiplied);
+	m_target->setView(m_lastView);
+}
+
+#ifdef GUI_PROFILING
+const Profiler& Frame::getProfiler() const
+{
+	return m_profiler;
+}
+#endif
+void Frame::callAction(const Entity& entity)
+{
+	GUI_PROFILE_SCOPE(m_profiler, ACTION);
+	GUI_TRACE_ENTITY("callAction", entity);
+	GUI_TRACK_CLASS(entity);
+	entity.callAction();
 }
 
+Functional::Functional()
+{
+	m_functional_object = FunctionalObject::NONE;
+}
 Functional::FunctionalObject Functional::getFunctionalFrame()
 {
 	return m_functional_object;
 }
+Frame* Functional::getFrame() const
+{
+	// climb through the pages and dropdowns holding the object
+	Functional* parent = nullptr;
+	switch (m_functional_object) {
+	case FunctionalObject::FRAME:
+		return (Frame*)this;
+	case FunctionalObject::PAGE:
+		parent = ((Page*)this)->getFunctionalParent();
+		break;
+	case FunctionalObject::DROPDOWN:
+		parent = ((Dropdown*)this)->getFunctionalParent();
+		break;
+	default:
+		return nullptr;
+	}
+	return parent != nullptr ? parent->getFrame() : nullptr;
+}
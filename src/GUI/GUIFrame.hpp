@@ -1,8 +1,18 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include "RenderBatch.hpp"
+#include "SpatialGrid.hpp"
+#include "InputSource.hpp"
+#include "Profiler.hpp"
+#include "Tracer.hpp"
+#include "AllocationTracker.hpp"
+#include "SlotMap.hpp"
+#include "NameRegistry.hpp"
+#include "Animator.hpp"
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <vector>
 
@@ -20,9 +30,30 @@ constexpr int GUI_ID_SCROLL = 5;
 constexpr int GUI_ID_DROPDOWN = 6;
 constexpr int GUI_ID_PAGE = 7; 
 
+class Entity;
+class Frame;
+
+////////////////////////////////////////////////////////////
+/// \brief State of the mouse, sampled once per update of a Frame
+///
+////////////////////////////////////////////////////////////
+struct Pointer {
+	sf::Vector2f position;	/// < position in the coordinates of the view of the window
+	sf::Vector2f delta;		/// < difference from the position at the previous update
+	unsigned int buttons;	/// < bit n is set if sf::Mouse::Button(n) is pressed
+	sf::Time timestamp;		/// < time of sampling, since the construction of the frame
+};
+
 class Functional {
 public:
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get the state of the mouse sampled by the frame
+	///		   at its last update, shared by every functional object
+	/// 
+	////////////////////////////////////////////////////////////
+	virtual const Pointer& getPointer() const = 0;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Get the mouse position with respect to the current window
 	/// 
@@ -64,8 +95,30 @@ public:
 
 	virtual bool pollEvents(sf::Event event) = 0;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Notify the object that one of its entities has changed
+	///		   and has to be drawn again
+	/// 
+	/// \param entity -> Entity which has changed
+	/// 
+	////////////////////////////////////////////////////////////
+	virtual void requestRedraw(const Entity& entity) = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Detach an entity from the object as it is destroyed,
+	///		   called by the destructor of the entity
+	///
+	/// Only the Id and address of the entity are read, the rest
+	/// of it is already destroyed
+	/// 
+	/// \param entity -> Entity being destroyed
+	/// 
+	////////////////////////////////////////////////////////////
+	virtual void detachDestroyed(const Entity& entity) = 0;
+
 
 	enum FunctionalObject {
+		NONE = -1,
 		FRAME = 0,
 		PAGE = GUI_ID_PAGE,
 		DROPDOWN = GUI_ID_DROPDOWN
@@ -79,12 +132,28 @@ public:
 	////////////////////////////////////////////////////////////
 	FunctionalObject getFunctionalFrame();
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get the frame the object is attached to, directly
+	///		   or through pages and dropdowns
+	/// 
+	/// \return Pointer to the frame, nullptr if the object is not attached
+	/// 
+	////////////////////////////////////////////////////////////
+	Frame* getFrame() const;
+
 	////////////////////////////////////////////////////////////
 	// Member Data
 	////////////////////////////////////////////////////////////
 
 protected: 
 
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor, the type is NONE until the
+	///		   derived object sets it
+	///
+	////////////////////////////////////////////////////////////
+	Functional();
+
 	////////////////////////////////////////////////////////////
 	/// \brief Set Record of wheter derived object is frame or page
 	///
@@ -92,8 +161,6 @@ protected:
 	FunctionalObject m_functional_object;
 };
 
-class Frame;
-
 class Entity : public sf::Transformable {
 	friend Frame;
 
@@ -117,6 +184,15 @@ protected:
 
 	Entity& operator=(const Entity& entity);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get the smallest rectangle containing both rectangles
+	///		   Rectangles without area are ignored
+	///
+	/// \return Union of both rectangles
+	/// 
+	////////////////////////////////////////////////////////////
+	static sf::FloatRect uniteRects(const sf::FloatRect& first, const sf::FloatRect& second);
+
 public:
 
 	////////////////////////////////////////////////////////////
@@ -131,7 +207,7 @@ public:
 	/// \return Unique ID of the object
 	/// 
 	////////////////////////////////////////////////////////////
-	unsigned int getID() const;
+	unsigned long long getID() const;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Get the unique Class ID of the object
@@ -141,6 +217,38 @@ public:
 	////////////////////////////////////////////////////////////
 	static unsigned int getClassID(const Entity& entity);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get the generational handle of the object
+	///
+	/// Unlike a pointer, the handle can be checked after the object
+	/// is destroyed, and unlike the Id it is never reused.
+	///
+	/// \return Handle of the object
+	/// 
+	////////////////////////////////////////////////////////////
+	Handle getHandle() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get an entity by its handle
+	///
+	/// \return Pointer to the entity, nullptr if it was destroyed
+	/// 
+	////////////////////////////////////////////////////////////
+	static Entity* get(const Handle& handle);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of entities alive
+	///
+	////////////////////////////////////////////////////////////
+	static std::size_t getLiveCount();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of entities destroyed so far, changes
+	///		   whenever some handle becomes invalid
+	///
+	////////////////////////////////////////////////////////////
+	static unsigned long long getDestroyedCount();
+
 	////////////////////////////////////////////////////////////
 	/// \brief Get the Frame attached to object
 	/// 
@@ -149,6 +257,126 @@ public:
 	////////////////////////////////////////////////////////////
 	Functional* getFunctionalParent() const;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get the animator of the frame the object is attached to,
+	///		   directly or through pages and dropdowns
+	/// 
+	/// \return Pointer to the animator, nullptr if the object is not attached
+	/// 
+	////////////////////////////////////////////////////////////
+	Animator* getAnimator() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the position of the object
+	///
+	/// \param x -> X coordinate of the new position
+	/// \param y -> Y coordinate of the new position
+	///
+	////////////////////////////////////////////////////////////
+	void setPosition(float x, float y);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the position of the object
+	///
+	/// \param position -> New position
+	///
+	////////////////////////////////////////////////////////////
+	void setPosition(const sf::Vector2f& position);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the orientation of the object
+	///
+	/// \param angle -> New rotation, in degrees
+	///
+	////////////////////////////////////////////////////////////
+	void setRotation(float angle);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the scale factors of the object
+	///
+	/// \param factorX -> New horizontal scale factor
+	/// \param factorY -> New vertical scale factor
+	///
+	////////////////////////////////////////////////////////////
+	void setScale(float factorX, float factorY);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the scale factors of the object
+	///
+	/// \param factors -> New scale factors
+	///
+	////////////////////////////////////////////////////////////
+	void setScale(const sf::Vector2f& factors);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the local origin of the object
+	///
+	/// \param x -> X coordinate of the new origin
+	/// \param y -> Y coordinate of the new origin
+	///
+	////////////////////////////////////////////////////////////
+	void setOrigin(float x, float y);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the local origin of the object
+	///
+	/// \param origin -> New origin
+	///
+	////////////////////////////////////////////////////////////
+	void setOrigin(const sf::Vector2f& origin);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move the object by a given offset
+	///
+	/// \param offsetX -> X offset
+	/// \param offsetY -> Y offset
+	///
+	////////////////////////////////////////////////////////////
+	void move(float offsetX, float offsetY);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move the object by a given offset
+	///
+	/// \param offset -> Offset
+	///
+	////////////////////////////////////////////////////////////
+	void move(const sf::Vector2f& offset);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rotate the object
+	///
+	/// \param angle -> Angle of rotation, in degrees
+	///
+	////////////////////////////////////////////////////////////
+	void rotate(float angle);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scale the object
+	///
+	/// \param factorX -> Horizontal scale factor
+	/// \param factorY -> Vertical scale factor
+	///
+	////////////////////////////////////////////////////////////
+	void scale(float factorX, float factorY);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scale the object
+	///
+	/// \param factor -> Scale factors
+	///
+	////////////////////////////////////////////////////////////
+	void scale(const sf::Vector2f& factor);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Notify the functional parent that the object has changed
+	///		   and has to be drawn again
+	///
+	/// Every setter of the gui objects calls it, call it manually only
+	/// if something the object depends on (e.g. a texture) is changed
+	/// 
+	////////////////////////////////////////////////////////////
+	void invalidate();
+
 	////////////////////////////////////////////////////////////
 	/// \brief Check if the point is inside the object
 	///		   Definition of if the point is inside the object may vary with different gui objects
@@ -172,12 +400,22 @@ public:
 
 	////////////////////////////////////////////////////////////
 	/// \brief Draws the object to the target applying its states
+	///		   Geometry is submitted to a batch which is flushed at the end
 	/// 
 	/// \param target -> Render target to draw to
 	/// \param states -> Current render states
 	/// 
 	////////////////////////////////////////////////////////////
-	virtual void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const = 0;
+	void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the geometry of the object to the batch applying its states
+	/// 
+	/// \param batch -> Batch collecting the geometry
+	/// \param states -> Current render states
+	/// 
+	////////////////////////////////////////////////////////////
+	virtual void submit(RenderBatch& batch, sf::RenderStates states = sf::RenderStates::Default) const = 0;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Actions to take upon selection of the object
@@ -191,6 +429,41 @@ public:
 	////////////////////////////////////////////////////////////
 	virtual void deactivateSelection() = 0;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Actions to take when the left button is pressed on the object,
+	///		   only records the press by default
+	///
+	////////////////////////////////////////////////////////////
+	virtual void activatePress();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Actions to take when the left button pressed on the object
+	///		   is released or the press is lost
+	///
+	////////////////////////////////////////////////////////////
+	virtual void deactivatePress();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the rectangle covered by everything the object draws
+	///
+	/// Unlike the global bounds it includes outlines and decorations
+	/// such as headers and scrolls. The rectangle is in the coordinate
+	/// system of the functional parent.
+	///
+	/// \return Bounding rectangle of the drawn object
+	///
+	////////////////////////////////////////////////////////////
+	virtual sf::FloatRect getDrawBounds() const = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the draw bounds computed when the object was last used
+	///		   since it was invalidated
+	///
+	/// \return Bounding rectangle of the drawn object
+	///
+	////////////////////////////////////////////////////////////
+	const sf::FloatRect& getCachedDrawBounds() const;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Get the selection of object
 	/// 
@@ -199,6 +472,14 @@ public:
 	////////////////////////////////////////////////////////////
 	bool isSelected() const;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get the press state of object
+	/// 
+	/// \return True if the left button was pressed on the object and is still held
+	///
+	////////////////////////////////////////////////////////////
+	bool isPressed() const;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Set the active state of the object to true
 	///
@@ -261,12 +542,35 @@ private:
 	////////////////////////////////////////////////////////////
 	friend void setFunctionalParent(Entity& entity, Functional* parent);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Set the entity which draws the entity as a part of itself
+	///		   (e.g. header of a page), changes are then reported by the owner
+	///
+	////////////////////////////////////////////////////////////
+	friend void setOwner(Entity& entity, Entity* owner);
+
 	////////////////////////////////////////////////////////////
 	/// \brief Set the Functional parent of entity's sub variables
 	///
 	////////////////////////////////////////////////////////////
 	virtual void setFunctionalParentForSubVariables(Functional* parent);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get the registry of all live entities, slots of destroyed
+	///		   entities are reused so Ids never run out
+	///
+	////////////////////////////////////////////////////////////
+	static SlotMap<Entity*>& registry();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Insert an entity in the registry
+	///
+	/// \return Handle of the entity, throws std::length_error if
+	///			every slot of a gui Id is taken
+	///
+	////////////////////////////////////////////////////////////
+	static Handle registerEntity(Entity& entity);
+
 
 	////////////////////////////////////////////////////////////
 	// Member data
@@ -276,17 +580,31 @@ public:
 
 protected:
 	bool m_selected;										/// < Selection State of the entity
+	bool m_pressed;											/// < Press State of the entity
 	std::function<void()> action;							/// < Job of the entity upon reaching specified event state 
 
 private:
-	unsigned int m_id;										/// < Unique id for every entity
+	unsigned long long m_id;								/// < Unique id, never reused, class Id in the 8 most significant bits, generation and slot of m_handle in the others
+	Handle m_handle;										/// < slot of the entity in the registry
 	bool m_active;											/// < State of the entity
 	Functional* m_functionalParent;							/// < Frame attached to entity, can be nullptr
-
-	static unsigned int item_count;							/// < Strictly increasing count of all constructed entities, Used for generating Ids, \
-																  makes up for the 24 least significant bits of Id
+	Entity* m_owner;										/// < Entity drawing this entity as its part, can be nullptr
+	mutable sf::FloatRect m_cachedBounds;					/// < draw bounds at the time of the last call to getCachedDrawBounds
+	mutable bool m_cachedBoundsValid;						/// < whether m_cachedBounds is up to date, reset by invalidate
 };
 
+////////////////////////////////////////////////////////////
+/// \brief Set the Functional parent of entity and of its sub variables
+///
+////////////////////////////////////////////////////////////
+void setFunctionalParent(Entity& entity, Functional* parent);
+
+////////////////////////////////////////////////////////////
+/// \brief Set the entity which draws the entity as a part of itself
+///
+////////////////////////////////////////////////////////////
+void setOwner(Entity& entity, Entity* owner);
+
 class Frame : Functional {
 public:
 	////////////////////////////////////////////////////////////
@@ -312,6 +630,35 @@ public:
 	////////////////////////////////////////////////////////////
 	void setWindow(sf::RenderWindow& window);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Draw on a render target other than a window, e.g. a render texture
+	///		   Input is not changed
+	/// 
+	/// \param target -> Render target used for drawing and mapping the mouse
+	/// 
+	////////////////////////////////////////////////////////////
+	void setRenderTarget(sf::RenderTarget& target);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Read events and mouse from another source than the window
+	///
+	/// Without render target the mouse is mapped one to one from pixels
+	/// and the frame has no bounds, so update and event polling run
+	/// without any window.
+	/// 
+	/// \param input -> Source of input, must outlive the frame or be replaced
+	/// 
+	////////////////////////////////////////////////////////////
+	void setInputSource(InputSource& input);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the current source of input
+	/// 
+	/// \return Pointer to the source, nullptr if none is set
+	/// 
+	////////////////////////////////////////////////////////////
+	InputSource* getInputSource() const;
+
 	////////////////////////////////////////////////////////////
 	/// \brief attach an entity to object
 	///
@@ -328,27 +675,70 @@ public:
 	/// \brief detach an entity to object by its unique Id
 	///
 	////////////////////////////////////////////////////////////
-	void removeEntity(unsigned int id);
+	void removeEntity(unsigned long long id);
 
 	////////////////////////////////////////////////////////////
-	/// \brief Set the global string name of the entity
+	/// \brief Move an attached entity above every other entity
+	///
+	/// Entities are drawn back to front and hit front to back in the
+	/// order they were attached, a raised entity is drawn last and hit first.
+	/// Top level pages and dropdowns are raised when they are pressed.
+	///
+	/// \param entity -> Attached entity to raise
 	///
 	////////////////////////////////////////////////////////////
-	static void setName(const Entity& entity, const std::string& name);
+	void raiseToFront(Entity& entity);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move an attached entity above every other entity by its unique Id
+	///
+	////////////////////////////////////////////////////////////
+	void raiseToFront(unsigned long long id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the name of the entity, unique within the frame
+	///		   and its pages
+	///
+	/// \param entity -> Entity whos name has to be set, replaces its previous name
+	/// \param name -> New name, taken away from any other entity
+	///
+	////////////////////////////////////////////////////////////
+	void setName(const Entity& entity, const Name& name);
 
 	////////////////////////////////////////////////////////////
 	/// \brief Remove name from any entity if the name exists
 	///
 	////////////////////////////////////////////////////////////
-	static void removeName(const std::string& name);
+	void removeName(const Name& name);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove the name of the entity if it has one
+	///
+	////////////////////////////////////////////////////////////
+	void removeName(const Entity& entity);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Detach an entity as it is destroyed and forget it if it
+	///		   was clicked, hovered or named, pages pass their children on
+	///
+	////////////////////////////////////////////////////////////
+	void detachDestroyed(const Entity& entity) override;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Get the entity attached to the object by Id
 	/// 
-	/// \return Pointer to Entity
+	/// \return Pointer to Entity, nullptr if no live entity with the Id is attached
 	///
 	////////////////////////////////////////////////////////////
-	Entity* getByID(unsigned int id) const;
+	Entity* getByID(unsigned long long id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the entity attached to the object by handle
+	/// 
+	/// \return Pointer to Entity, nullptr if it is not attached or was destroyed
+	///
+	////////////////////////////////////////////////////////////
+	Entity* getByHandle(const Handle& handle) const;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Get the entity attached to the object by its name if the name exists
@@ -356,22 +746,30 @@ public:
 	/// \return Pointer to Entity
 	///
 	////////////////////////////////////////////////////////////
-	Entity* getByName(const std::string& name) const;
+	Entity* getByName(const Name& name) const;
 
 	////////////////////////////////////////////////////////////
-	/// \brief Get the entity attached to the object by Id
+	/// \brief Get the Id of the entity by its name
 	/// 
-	/// \return Pointer to Entity
+	/// \return gui Id, 0 if no live entity has the name
 	///
 	////////////////////////////////////////////////////////////
-	static unsigned int getIDByName(const std::string& name);
+	unsigned long long getIDByName(const Name& name) const;
 
+	////////////////////////////////////////////////////////////
 	/// \brief Get the name of the entity by its Id
 	/// 
 	/// \return The name is it exists else empty string
 	///
 	////////////////////////////////////////////////////////////
-	static std::string getName(unsigned int id);
+	const std::string& getName(unsigned long long id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the state of the mouse sampled at the last update
+	///		   or by the last mouse event
+	/// 
+	////////////////////////////////////////////////////////////
+	const Pointer& getPointer() const override;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Get the mouse position with respect to the current window
@@ -427,25 +825,251 @@ public:
 	////////////////////////////////////////////////////////////
 	bool pollEvents(sf::Event event);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Read every pending event of the input source
+	/// 
+	/// \return Number of events read
+	/// 
+	////////////////////////////////////////////////////////////
+	unsigned int pollInputEvents();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Notify the object that one of its entities has changed
+	///		   and has to be drawn again
+	/// 
+	/// \param entity -> Entity which has changed
+	/// 
+	////////////////////////////////////////////////////////////
+	void requestRedraw(const Entity& entity) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the color the window is cleared with below the entities
+	/// 
+	/// By default, the clear color is opaque black and hides what
+	/// the application drew below the viewport. A translucent color
+	/// lets it show through, blended once with the alpha of the color.
+	/// 
+	/// \param color -> New clear color
+	/// 
+	////////////////////////////////////////////////////////////
+	void setClearColor(const sf::Color& color);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of pixels redrawn by the last call to draw
+	/// 
+	/// \return Area of all damaged rectangles, in pixels
+	/// 
+	////////////////////////////////////////////////////////////
+	unsigned int getDamagedPixelCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of entities drawn by the last call to draw
+	/// 
+	/// An entity overlapping several damaged rectangles is counted once per rectangle
+	/// 
+	/// \return Number of drawn entities
+	/// 
+	////////////////////////////////////////////////////////////
+	unsigned int getRedrawnEntityCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of draw calls issued by the last call to draw
+	/// 
+	/// Geometry of entities is batched, consecutive entities sharing
+	/// a texture and blend mode cost a single draw call
+	/// 
+	/// \return Number of draw calls
+	/// 
+	////////////////////////////////////////////////////////////
+	unsigned int getDrawCallCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the rendering costs of the last call to draw
+	/// 
+	/// \return Draw calls, vertices, texture switches and surfaces created
+	/// 
+	////////////////////////////////////////////////////////////
+	const RenderBatch::Stats& getRenderStats() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the rendering costs of an entity in the last call to draw
+	/// 
+	/// Costs of children of pages and dropdowns are attributed to
+	/// the children, not to their parents
+	/// 
+	/// \param id -> gui Id of the entity, attached to the object or not
+	/// 
+	/// \return Costs of the entity, zero if it was not drawn
+	/// 
+	////////////////////////////////////////////////////////////
+	RenderBatch::Stats getRenderStats(unsigned long long id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if the next call to draw would change anything
+	/// 
+	/// \return true if an entity has changed, been added or removed,
+	///			or the window has been resized or its view changed
+	/// 
+	////////////////////////////////////////////////////////////
+	bool hasPendingRedraw() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if the object can wait for the next event
+	///
+	/// The object is idle if nothing has to be redrawn, no animation is
+	/// running and no action has to be called every update, such as mouse
+	/// held or mouse hover actions.
+	/// While idle, calls to update and draw can be skipped until an event arrives.
+	/// 
+	/// \return true if the object is idle, false otherwise
+	/// 
+	////////////////////////////////////////////////////////////
+	bool isIdle() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the animator of the object
+	///
+	/// Animations advance on each update with the time of the input source
+	/// 
+	////////////////////////////////////////////////////////////
+	Animator& getAnimator();
+
 	////////////////////////////////////////////////////////////
 	/// \brief Draw every entity attached to the object on current window
+	///
+	/// Entities are drawn on a retained backbuffer, only the regions
+	/// damaged by changed, added or removed entities are drawn again
+	/// before the backbuffer is copied to the window.
+	/// Only the viewport of the view of the window is copied. The
+	/// backbuffer holds premultiplied colors, so with a translucent
+	/// clear color what the application drew on the window before
+	/// shows below the entities, each alpha applied once.
 	/// 
 	////////////////////////////////////////////////////////////
 	void draw();
 
+#ifdef GUI_PROFILING
+	////////////////////////////////////////////////////////////
+	/// \brief Get the timings of the object, only with GUI_PROFILING defined
+	///
+	/// A frame of the profiler ends with each call to draw
+	/// 
+	////////////////////////////////////////////////////////////
+	const Profiler& getProfiler() const;
+#endif
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Map a rectangle from world coordinates to window pixels
+	///		   through the current view of the window
+	/// 
+	/// \return Padded pixel rectangle clamped to the window
+	/// 
+	////////////////////////////////////////////////////////////
+	sf::IntRect mapRectToPixels(const sf::FloatRect& rect) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if the view of the window has changed since the last draw
+	/// 
+	////////////////////////////////////////////////////////////
+	bool hasViewChanged() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sample the state of the mouse into the pointer
+	/// 
+	////////////////////////////////////////////////////////////
+	void samplePointer();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move the pointer to the position of a mouse event
+	/// 
+	/// \param pixel -> Position of the event in pixels
+	/// 
+	////////////////////////////////////////////////////////////
+	void movePointer(const sf::Vector2i& pixel);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove the tombstones of the display list if they take
+	///		   more than half of it, keeping the order of entities
+	/// 
+	////////////////////////////////////////////////////////////
+	void compactDisplayList();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Find the slot of an attached entity in the display list
+	/// 
+	/// \return Slot of the entity, noSlot if it is not attached
+	/// 
+	////////////////////////////////////////////////////////////
+	std::size_t findSlot(unsigned long long id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Detach an entity by Id without touching the entity,
+	///		   leaves a tombstone in the display list
+	/// 
+	////////////////////////////////////////////////////////////
+	void detach(unsigned long long id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Call the action of an entity, timed as an action
+	/// 
+	////////////////////////////////////////////////////////////
+	void callAction(const Entity& entity);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Slot of the display list
+	/// 
+	////////////////////////////////////////////////////////////
+	struct DisplayItem {
+		Entity* entity;			/// < attached entity, nullptr if the slot is a tombstone
+		Functional* functional;	/// < the same entity if it is a page or dropdown, nullptr otherwise
+		unsigned long long id;	/// < gui Id of the entity, still readable once the entity is destroyed
+		Handle handle;			/// < handle of the entity, invalid once the entity is destroyed
+	};
+
+	static const std::size_t noSlot = ~std::size_t(0);	/// < slot of entities which are not attached
+
 
 	////////////////////////////////////////////////////////////
 	// Member Data
 	////////////////////////////////////////////////////////////
 private:
-	sf::RenderWindow* m_window;											/// < main window of the frame (handles mouse position and rendering)
+	sf::RenderTarget* m_target;											/// < target of the frame (handles mouse mapping and rendering), can be nullptr
+	sf::ContextSettings m_settings;										/// < settings of the backbuffer, taken from the window
+	WindowInput m_windowInput;											/// < input read from the window set by setWindow
+	InputSource* m_input;												/// < current source of events and mouse, can be nullptr
 	Entity* m_mouseHoveringOn;											/// < last Entity over which mouse button was
 	Entity *m_clicked;													/// < last Entity on which mouse button was pressed
+	Handle m_hoverHandle;												/// < handle of m_mouseHoveringOn, tells if it was destroyed
+	Handle m_clickedHandle;												/// < handle of m_clicked, tells if it was destroyed
 	sf::Vector2f m_lastMousePos;										/// < last mouse Position on the current window
-	std::unordered_map<unsigned int, Entity*> m_entityMap;				/// < maps gui Ids to their respective entities
-	std::unordered_map<unsigned int, Functional*> m_functionalParents;	/// < maps gui Ids of functional parents to their respective entities (also in entityMap)
-
-	static std::unordered_map<std::string, unsigned int> m_nameMap;		/// < maps from names to the gui Id of their respective entities, Single Map for all Frame objects
+	Pointer m_pointer;													/// < state of the mouse at the last update
+	sf::Vector2f m_hitPosition;											/// < mouse position of the last hover hit test
+	bool m_sceneChanged;												/// < whether an entity has changed since the last hover hit test
+	std::vector<DisplayItem> m_displayList;								/// < attached entities ordered back to front, removed entities leave tombstones
+	std::vector<std::size_t> m_displaySlots;							/// < slot in the display list of every entity slot of the registry, noSlot if not attached
+	std::size_t m_tombstoneCount;										/// < number of tombstones in the display list
+	SpatialGrid m_grid;													/// < attached entities indexed by their draw bounds
+	unsigned int m_nextOrder;											/// < stacking order of the next added or raised entity
+	std::vector<Entity*> m_found;										/// < reused storage for queries of m_grid
+
+	sf::RenderTexture m_backbuffer;										/// < retained image of all entities, only damaged regions are redrawn
+	sf::View m_lastView;												/// < view of the window during the last draw
+	unsigned long long m_themeChangeCount;								/// < swaps of themes seen by the last draw
+	sf::Color m_clearColor;												/// < color of the backbuffer below the entities
+	bool m_fullRedraw;													/// < whether the whole backbuffer is damaged
+	std::unordered_set<unsigned long long> m_dirtyEntities;				/// < gui Ids of entities changed since the last draw
+	std::unordered_map<unsigned long long, sf::FloatRect> m_drawnBounds;	/// < draw bounds of entities at the time of their last draw
+	std::vector<sf::FloatRect> m_removedBounds;							/// < draw bounds of entities removed since the last draw
+	std::vector<sf::IntRect> m_damage;									/// < damaged pixel rectangles of the current draw
+	unsigned int m_damagedPixelCount;									/// < area of damaged rectangles in the last draw
+	unsigned int m_redrawnEntityCount;									/// < number of entities drawn in the last draw
+	RenderBatch m_batch;												/// < collects geometry of entities drawn on the backbuffer
+	NameRegistry m_names;												/// < names of the entities of the frame and its pages
+	Animator m_animator;												/// < animations of the entities of the frame and its pages
+#ifdef GUI_PROFILING
+	Profiler m_profiler;												/// < timings of the phases of the object
+#endif
 };
 
 } // namespace gui
\ No newline at end of file
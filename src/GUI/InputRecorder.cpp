@@ -0,0 +1,354 @@
+#include "InputRecorder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace gui;
+
+static const char magic[4] = { 'G', 'U', 'I', 'R' };
+static const unsigned char version = 1;
+
+////////////////////////////////////////////////////////////
+// binary helpers
+////////////////////////////////////////////////////////////
+
+static void writeVarint(std::vector<unsigned char>& out, sf::Uint64 value)
+{
+	while (value >= 0x80) {
+		out.push_back((unsigned char)(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((unsigned char)value);
+}
+
+static void writeSigned(std::vector<unsigned char>& out, sf::Int64 value)
+{
+	// zigzag keeps small negative numbers small
+	writeVarint(out, ((sf::Uint64)value << 1) ^ (sf::Uint64)(value >> 63));
+}
+
+static void writeFloat(std::vector<unsigned char>& out, float value)
+{
+	sf::Uint32 bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	for (int i = 0; i < 4; i++)out.push_back((unsigned char)(bits >> (8 * i)));
+}
+
+namespace {
+
+// reader over a loaded file, every read fails once the end is passed
+struct Reader {
+	const std::vector<unsigned char>& data;
+	std::size_t position;
+	bool failed;
+
+	unsigned char readByte()
+	{
+		if (position >= data.size()) {
+			failed = true;
+			return 0;
+		}
+		return data[position++];
+	}
+
+	sf::Uint64 readVarint()
+	{
+		sf::Uint64 value = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			unsigned char byte = readByte();
+			value |= (sf::Uint64)(byte & 0x7F) << shift;
+			if (!(byte & 0x80))return value;
+		}
+		failed = true;
+		return value;
+	}
+
+	sf::Int64 readSigned()
+	{
+		sf::Uint64 value = readVarint();
+		return (sf::Int64)(value >> 1) ^ -(sf::Int64)(value & 1);
+	}
+
+	float readFloat()
+	{
+		sf::Uint32 bits = 0;
+		for (int i = 0; i < 4; i++)bits |= (sf::Uint32)readByte() << (8 * i);
+
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+};
+
+} // namespace
+
+static void writeEvent(std::vector<unsigned char>& out, const sf::Event& event)
+{
+	out.push_back((unsigned char)event.type);
+
+	switch (event.type) {
+	case sf::Event::Resized:
+		writeVarint(out, event.size.width);
+		writeVarint(out, event.size.height);
+		break;
+	case sf::Event::TextEntered:
+		writeVarint(out, event.text.unicode);
+		break;
+	case sf::Event::KeyPressed:
+	case sf::Event::KeyReleased:
+		writeSigned(out, event.key.code);
+		out.push_back((unsigned char)(event.key.alt | event.key.control << 1 | event.key.shift << 2 | event.key.system << 3));
+		break;
+	case sf::Event::MouseWheelScrolled:
+		out.push_back((unsigned char)event.mouseWheelScroll.wheel);
+		writeFloat(out, event.mouseWheelScroll.delta);
+		writeSigned(out, event.mouseWheelScroll.x);
+		writeSigned(out, event.mouseWheelScroll.y);
+		break;
+	case sf::Event::MouseButtonPressed:
+	case sf::Event::MouseButtonReleased:
+		out.push_back((unsigned char)event.mouseButton.button);
+		writeSigned(out, event.mouseButton.x);
+		writeSigned(out, event.mouseButton.y);
+		break;
+	case sf::Event::MouseMoved:
+		writeSigned(out, event.mouseMove.x);
+		writeSigned(out, event.mouseMove.y);
+		break;
+	default:
+		// remaining events used by the gui carry no data
+		break;
+	}
+}
+
+static sf::Event readEvent(Reader& in)
+{
+	sf::Event event;
+	std::memset(&event, 0, sizeof(event));
+
+	unsigned char type = in.readByte();
+	if (type >= sf::Event::Count) {
+		in.failed = true;
+		return event;
+	}
+	event.type = (sf::Event::EventType)type;
+
+	switch (event.type) {
+	case sf::Event::Resized:
+		event.size.width = (unsigned int)in.readVarint();
+		event.size.height = (unsigned int)in.readVarint();
+		break;
+	case sf::Event::TextEntered:
+		event.text.unicode = (sf::Uint32)in.readVarint();
+		break;
+	case sf::Event::KeyPressed:
+	case sf::Event::KeyReleased: {
+		event.key.code = (sf::Keyboard::Key)in.readSigned();
+		unsigned char modifiers = in.readByte();
+		event.key.alt = modifiers & 1;
+		event.key.control = (modifiers >> 1) & 1;
+		event.key.shift = (modifiers >> 2) & 1;
+		event.key.system = (modifiers >> 3) & 1;
+		break;
+	}
+	case sf::Event::MouseWheelScrolled:
+		event.mouseWheelScroll.wheel = (sf::Mouse::Wheel)in.readByte();
+		event.mouseWheelScroll.delta = in.readFloat();
+		event.mouseWheelScroll.x = (int)in.readSigned();
+		event.mouseWheelScroll.y = (int)in.readSigned();
+		break;
+	case sf::Event::MouseButtonPressed:
+	case sf::Event::MouseButtonReleased:
+		event.mouseButton.button = (sf::Mouse::Button)in.readByte();
+		event.mouseButton.x = (int)in.readSigned();
+		event.mouseButton.y = (int)in.readSigned();
+		break;
+	case sf::Event::MouseMoved:
+		event.mouseMove.x = (int)in.readSigned();
+		event.mouseMove.y = (int)in.readSigned();
+		break;
+	default:
+		break;
+	}
+	return event;
+}
+
+////////////////////////////////////////////////////////////
+// InputRecorder
+////////////////////////////////////////////////////////////
+
+InputRecorder::InputRecorder()
+{
+	m_source = nullptr;
+	m_recording = false;
+	m_current = { std::vector<sf::Event>(), sf::Vector2i(), 0, false, sf::Time::Zero };
+}
+
+void InputRecorder::setSource(InputSource& source)
+{
+	m_source = &source;
+}
+
+void InputRecorder::start()
+{
+	m_frames.clear();
+	m_current.events.clear();
+	m_startTime = m_source != nullptr ? m_source->getTime() : sf::Time::Zero;
+	m_recording = true;
+}
+
+void InputRecorder::stop()
+{
+	m_recording = false;
+}
+
+bool InputRecorder::isRecording() const
+{
+	return m_recording;
+}
+
+void InputRecorder::recordEvent(const sf::Event& event)
+{
+	if (m_recording)m_current.events.push_back(event);
+}
+
+const std::vector<InputFrame>& InputRecorder::getFrames() const
+{
+	return m_frames;
+}
+
+bool InputRecorder::saveToFile(const std::string& filename) const
+{
+	return saveToFile(filename, m_frames);
+}
+
+bool InputRecorder::saveToFile(const std::string& filename, const std::vector<InputFrame>& frames)
+{
+	std::vector<unsigned char> out(magic, magic + 4);
+	out.push_back(version);
+	writeVarint(out, frames.size());
+
+	// time and mouse are stored as differences from the previous frame
+	sf::Int64 lastTime = 0;
+	sf::Vector2i lastPosition;
+	for (auto frame = frames.begin(); frame != frames.end(); frame++) {
+		writeVarint(out, (sf::Uint64)std::max<sf::Int64>(0, frame->time.asMicroseconds() - lastTime));
+		writeSigned(out, frame->mousePosition.x - lastPosition.x);
+		writeSigned(out, frame->mousePosition.y - lastPosition.y);
+		out.push_back((unsigned char)((frame->buttons & 0x7F) | (frame->focus ? 0x80 : 0)));
+
+		writeVarint(out, frame->events.size());
+		for (auto event = frame->events.begin(); event != frame->events.end(); event++)
+			writeEvent(out, *event);
+
+		lastTime = std::max(lastTime, frame->time.asMicroseconds());
+		lastPosition = frame->mousePosition;
+	}
+
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)return false;
+
+	file.write((const char*)out.data(), out.size());
+	return (bool)file;
+}
+
+bool InputRecorder::loadFromFile(const std::string& filename, std::vector<InputFrame>& frames)
+{
+	frames.clear();
+
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)return false;
+
+	std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	if (data.size() < 5 || std::memcmp(data.data(), magic, 4) != 0 || data[4] != version)return false;
+
+	Reader in = { data, 5, false };
+	sf::Uint64 count = in.readVarint();
+
+	sf::Int64 time = 0;
+	sf::Vector2i position;
+	for (sf::Uint64 i = 0; i < count && !in.failed; i++) {
+		InputFrame frame;
+
+		time += (sf::Int64)in.readVarint();
+		position.x += (int)in.readSigned();
+		position.y += (int)in.readSigned();
+		unsigned char flags = in.readByte();
+
+		frame.time = sf::microseconds(time);
+		frame.mousePosition = position;
+		frame.buttons = flags & 0x7F;
+		frame.focus = (flags & 0x80) != 0;
+
+		sf::Uint64 eventCount = in.readVarint();
+		for (sf::Uint64 j = 0; j < eventCount && !in.failed; j++)
+			frame.events.push_back(readEvent(in));
+
+		frames.push_back(frame);
+	}
+
+	if (in.failed) {
+		frames.clear();
+		return false;
+	}
+	return true;
+}
+
+bool InputRecorder::pollEvent(sf::Event& event)
+{
+	if (m_source == nullptr || !m_source->pollEvent(event))return false;
+
+	recordEvent(event);
+	return true;
+}
+
+sf::Vector2i InputRecorder::getMousePosition() const
+{
+	if (m_source == nullptr)return sf::Vector2i();
+
+	m_current.mousePosition = m_source->getMousePosition();
+	return m_current.mousePosition;
+}
+
+bool InputRecorder::isButtonPressed(sf::Mouse::Button button) const
+{
+	if (m_source == nullptr)return false;
+
+	bool pressed = m_source->isButtonPressed(button);
+	if (pressed)m_current.buttons |= 1u << button;
+	else m_current.buttons &= ~(1u << button);
+	return pressed;
+}
+
+bool InputRecorder::hasFocus() const
+{
+	if (m_source == nullptr)return false;
+
+	m_current.focus = m_source->hasFocus();
+	return m_current.focus;
+}
+
+sf::Time InputRecorder::getTime() const
+{
+	if (m_source == nullptr)return sf::Time::Zero;
+
+	m_current.time = m_source->getTime();
+	return m_current.time;
+}
+
+void InputRecorder::nextFrame()
+{
+	if (m_source != nullptr)m_source->nextFrame();
+
+	if (m_recording) {
+		// frames are timed from the start of the recording
+		InputFrame frame = m_current;
+		frame.time = getTime() - m_startTime;
+		m_frames.push_back(frame);
+	}
+
+	// mouse state carries over to the next frame
+	m_current.events.clear();
+}
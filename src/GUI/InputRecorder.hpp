@@ -0,0 +1,111 @@
+#pragma once
+
+#include "InputSource.hpp"
+#include <string>
+#include <vector>
+
+namespace gui {
+
+////////////////////////////////////////////////////////////
+/// \brief Input source recording everything read from another source
+///
+/// Events are recorded as they are polled and the mouse state as it is
+/// sampled by the frame, so a recording holds exactly what the frame saw.
+/// Every update of the frame closes one recorded frame.
+///
+/// Recordings are saved in a compact binary format :
+///		header -> "GUIR", version (1 byte), frame count (varint)
+///		frame -> time delta in microseconds (varint), mouse delta (2 zigzag varints),
+///				 flags (1 byte : buttons, focus in bit 7), event count (varint), events
+///		event -> type (1 byte) followed by the fields used by that type
+///
+////////////////////////////////////////////////////////////
+class InputRecorder : public InputSource {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor, recorder without source has no input
+	///
+	////////////////////////////////////////////////////////////
+	InputRecorder();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the source to read and record from
+	///
+	////////////////////////////////////////////////////////////
+	void setSource(InputSource& source);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Discard the recorded frames and start recording
+	///
+	////////////////////////////////////////////////////////////
+	void start();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Stop recording, recorded frames are kept
+	///
+	////////////////////////////////////////////////////////////
+	void stop();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if the recorder is recording
+	///
+	////////////////////////////////////////////////////////////
+	bool isRecording() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Record an event which was not read through the recorder
+	///		   (e.g. returned by sf::Window::waitEvent)
+	///
+	////////////////////////////////////////////////////////////
+	void recordEvent(const sf::Event& event);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the recorded frames
+	///
+	////////////////////////////////////////////////////////////
+	const std::vector<InputFrame>& getFrames() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Save the recorded frames to a file
+	///
+	/// \return true if the file was written
+	///
+	////////////////////////////////////////////////////////////
+	bool saveToFile(const std::string& filename) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Save frames to a file
+	///
+	/// \return true if the file was written
+	///
+	////////////////////////////////////////////////////////////
+	static bool saveToFile(const std::string& filename, const std::vector<InputFrame>& frames);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Load frames saved by saveToFile
+	///
+	/// \param filename -> Path of the file
+	/// \param frames -> Loaded frames, previous content is cleared
+	///
+	/// \return true if the file was read, false if it is missing or malformed
+	///
+	////////////////////////////////////////////////////////////
+	static bool loadFromFile(const std::string& filename, std::vector<InputFrame>& frames);
+
+	bool pollEvent(sf::Event& event) override;
+	sf::Vector2i getMousePosition() const override;
+	bool isButtonPressed(sf::Mouse::Button button) const override;
+	bool hasFocus() const override;
+	sf::Time getTime() const override;
+	void nextFrame() override;
+
+private:
+	InputSource* m_source;				/// < source read and recorded
+	bool m_recording;					/// < whether frames are recorded
+	sf::Time m_startTime;				/// < time of the source when recording started
+	mutable InputFrame m_current;		/// < frame being recorded
+	std::vector<InputFrame> m_frames;	/// < recorded frames
+};
+
+} // namespace gui
@@ -0,0 +1,103 @@
+#include "InputReplay.hpp"
+#include "InputRecorder.hpp"
+
+#include <fstream>
+
+using namespace gui;
+
+InputReplay::InputReplay()
+{
+
+}
+
+bool InputReplay::loadFromFile(const std::string& filename)
+{
+	std::vector<InputFrame> frames;
+	if (!InputRecorder::loadFromFile(filename, frames))return false;
+
+	setFrames(frames);
+	return true;
+}
+
+void InputReplay::setFrames(const std::vector<InputFrame>& frames)
+{
+	m_input.setFrames(frames);
+	m_timings.clear();
+}
+
+void InputReplay::run(Frame& frame, bool realTime, const std::function<void()>& present)
+{
+	InputSource* previous = frame.getInputSource();
+	frame.setInputSource(m_input);
+
+	m_input.rewind();
+	m_timings.clear();
+	m_timings.reserve(m_input.getFrames().size());
+
+	sf::Clock clock;
+	sf::Clock timer;
+	while (!m_input.isFinished()) {
+		FrameTiming timing;
+		timing.time = m_input.getTime();
+
+		// recorded times start at the first frame
+		if (realTime) {
+			sf::Time wait = timing.time - m_input.getFrames().front().time - clock.getElapsedTime();
+			if (wait > sf::Time::Zero)sf::sleep(wait);
+		}
+
+		// update moves the input to the next frame
+		timer.restart();
+		timing.events = frame.pollInputEvents();
+		timing.dispatch = timer.restart();
+		frame.update();
+		timing.update = timer.restart();
+		frame.draw();
+		timing.draw = timer.restart();
+		timing.drawCalls = frame.getDrawCallCount();
+
+		if (present)present();
+		m_timings.push_back(timing);
+	}
+
+	if (previous != nullptr)frame.setInputSource(*previous);
+}
+
+const std::vector<InputReplay::FrameTiming>& InputReplay::getTimings() const
+{
+	return m_timings;
+}
+
+sf::Time InputReplay::getTotalTime() const
+{
+	sf::Time total;
+	for (auto it = m_timings.begin(); it != m_timings.end(); it++)
+		total += it->dispatch + it->update + it->draw;
+	return total;
+}
+
+std::size_t InputReplay::getSlowestFrame() const
+{
+	std::size_t slowest = 0;
+	for (std::size_t i = 1; i < m_timings.size(); i++) {
+		const FrameTiming& a = m_timings[i];
+		const FrameTiming& b = m_timings[slowest];
+		if (a.dispatch + a.update + a.draw > b.dispatch + b.update + b.draw)slowest = i;
+	}
+	return slowest;
+}
+
+bool InputReplay::saveReport(const std::string& filename) const
+{
+	std::ofstream file(filename);
+	if (!file)return false;
+
+	file << "frame,time,events,dispatch,update,draw,draw_calls\n";
+	for (std::size_t i = 0; i < m_timings.size(); i++) {
+		const FrameTiming& timing = m_timings[i];
+		file << i << ',' << timing.time.asMicroseconds() << ',' << timing.events << ','
+			<< timing.dispatch.asMicroseconds() << ',' << timing.update.asMicroseconds() << ','
+			<< timing.draw.asMicroseconds() << ',' << timing.drawCalls << '\n';
+	}
+	return (bool)file;
+}
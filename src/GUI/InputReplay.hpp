@@ -0,0 +1,101 @@
+#pragma once
+
+#include "GUIFrame.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace gui {
+
+////////////////////////////////////////////////////////////
+/// \brief Replay a recorded input session against a Frame and time each frame
+///
+/// Each recorded frame runs pollInputEvents, update and draw on the frame,
+/// in that order, as a live loop would. Timings can be compared between
+/// builds to catch performance regressions on the exact same session.
+///
+////////////////////////////////////////////////////////////
+class InputReplay {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Timings of one replayed frame
+	///
+	////////////////////////////////////////////////////////////
+	struct FrameTiming {
+		sf::Time time;				/// < recorded time of the frame
+		unsigned int events;		/// < number of events dispatched
+		sf::Time dispatch;			/// < time spent in Frame::pollInputEvents
+		sf::Time update;			/// < time spent in Frame::update
+		sf::Time draw;				/// < time spent in Frame::draw
+		unsigned int drawCalls;		/// < draw calls issued by Frame::draw
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor
+	///
+	////////////////////////////////////////////////////////////
+	InputReplay();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Load a session saved by InputRecorder
+	///
+	/// \return true if the session was loaded
+	///
+	////////////////////////////////////////////////////////////
+	bool loadFromFile(const std::string& filename);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the frames of the session
+	///
+	////////////////////////////////////////////////////////////
+	void setFrames(const std::vector<InputFrame>& frames);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Replay the whole session
+	///
+	/// The input source of the frame is replaced during the replay
+	/// and restored afterwards.
+	///
+	/// \param frame -> Frame to replay against
+	/// \param realTime -> true to wait for the recorded time of each frame,
+	///					   false to replay as fast as possible
+	/// \param present -> Called after each draw, e.g. to display the window, not timed
+	///
+	////////////////////////////////////////////////////////////
+	void run(Frame& frame, bool realTime = false, const std::function<void()>& present = nullptr);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the timings of the last run, one per recorded frame
+	///
+	////////////////////////////////////////////////////////////
+	const std::vector<FrameTiming>& getTimings() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the sum of dispatch, update and draw time of the last run
+	///
+	////////////////////////////////////////////////////////////
+	sf::Time getTotalTime() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the index of the slowest frame of the last run
+	///
+	/// \return Index in getTimings, 0 if nothing was replayed
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getSlowestFrame() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write the timings of the last run as CSV, times in microseconds
+	///
+	/// \return true if the file was written
+	///
+	////////////////////////////////////////////////////////////
+	bool saveReport(const std::string& filename) const;
+
+private:
+	RecordedInput m_input;					/// < recorded session
+	std::vector<FrameTiming> m_timings;		/// < timings of the last run
+};
+
+} // namespace gui
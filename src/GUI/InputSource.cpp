@@ -0,0 +1,253 @@
+#include "InputSource.hpp"
+
+#include <algorithm>
+
+using namespace gui;
+
+InputSource::~InputSource()
+{
+
+}
+
+void InputSource::nextFrame()
+{
+
+}
+
+////////////////////////////////////////////////////////////
+// WindowInput
+////////////////////////////////////////////////////////////
+
+WindowInput::WindowInput()
+{
+	m_window = nullptr;
+}
+
+void WindowInput::setWindow(sf::Window& window)
+{
+	m_window = &window;
+}
+
+bool WindowInput::pollEvent(sf::Event& event)
+{
+	return m_window != nullptr && m_window->pollEvent(event);
+}
+
+sf::Vector2i WindowInput::getMousePosition() const
+{
+	return m_window != nullptr ? sf::Mouse::getPosition(*m_window) : sf::Vector2i();
+}
+
+bool WindowInput::isButtonPressed(sf::Mouse::Button button) const
+{
+	return sf::Mouse::isButtonPressed(button);
+}
+
+bool WindowInput::hasFocus() const
+{
+	return m_window != nullptr && m_window->hasFocus();
+}
+
+sf::Time WindowInput::getTime() const
+{
+	return m_clock.getElapsedTime();
+}
+
+////////////////////////////////////////////////////////////
+// ScriptedInput
+////////////////////////////////////////////////////////////
+
+ScriptedInput::ScriptedInput()
+{
+	m_buttons = 0;
+	m_focus = true;
+	m_time = sf::Time::Zero;
+}
+
+void ScriptedInput::pushEvent(const sf::Event& event)
+{
+	if (event.type == sf::Event::MouseMoved)
+		m_pushedPosition = sf::Vector2i(event.mouseMove.x, event.mouseMove.y);
+
+	m_events.push_back(event);
+}
+
+void ScriptedInput::moveMouse(int x, int y)
+{
+	sf::Event event;
+	event.type = sf::Event::MouseMoved;
+	event.mouseMove.x = x;
+	event.mouseMove.y = y;
+	pushEvent(event);
+}
+
+void ScriptedInput::pressButton(sf::Mouse::Button button)
+{
+	sf::Event event;
+	event.type = sf::Event::MouseButtonPressed;
+	event.mouseButton.button = button;
+	event.mouseButton.x = m_pushedPosition.x;
+	event.mouseButton.y = m_pushedPosition.y;
+	pushEvent(event);
+}
+
+void ScriptedInput::releaseButton(sf::Mouse::Button button)
+{
+	sf::Event event;
+	event.type = sf::Event::MouseButtonReleased;
+	event.mouseButton.button = button;
+	event.mouseButton.x = m_pushedPosition.x;
+	event.mouseButton.y = m_pushedPosition.y;
+	pushEvent(event);
+}
+
+void ScriptedInput::scrollWheel(float delta)
+{
+	sf::Event event;
+	event.type = sf::Event::MouseWheelScrolled;
+	event.mouseWheelScroll.wheel = sf::Mouse::VerticalWheel;
+	event.mouseWheelScroll.delta = delta;
+	event.mouseWheelScroll.x = m_pushedPosition.x;
+	event.mouseWheelScroll.y = m_pushedPosition.y;
+	pushEvent(event);
+}
+
+void ScriptedInput::enterText(sf::Uint32 unicode)
+{
+	sf::Event event;
+	event.type = sf::Event::TextEntered;
+	event.text.unicode = unicode;
+	pushEvent(event);
+}
+
+void ScriptedInput::setFocus(bool focus)
+{
+	m_focus = focus;
+}
+
+void ScriptedInput::advanceTime(sf::Time time)
+{
+	m_time += time;
+}
+
+std::size_t ScriptedInput::getPendingEventCount() const
+{
+	return m_events.size();
+}
+
+bool ScriptedInput::pollEvent(sf::Event& event)
+{
+	if (m_events.empty())return false;
+
+	event = m_events.front();
+	m_events.pop_front();
+
+	// mouse state follows the polled events
+	if (event.type == sf::Event::MouseMoved)
+		m_position = sf::Vector2i(event.mouseMove.x, event.mouseMove.y);
+	else if (event.type == sf::Event::MouseButtonPressed)
+		m_buttons |= 1u << event.mouseButton.button;
+	else if (event.type == sf::Event::MouseButtonReleased)
+		m_buttons &= ~(1u << event.mouseButton.button);
+	else if (event.type == sf::Event::LostFocus)
+		m_focus = false;
+	else if (event.type == sf::Event::GainedFocus)
+		m_focus = true;
+
+	return true;
+}
+
+sf::Vector2i ScriptedInput::getMousePosition() const
+{
+	return m_position;
+}
+
+bool ScriptedInput::isButtonPressed(sf::Mouse::Button button) const
+{
+	return (m_buttons >> button) & 1u;
+}
+
+bool ScriptedInput::hasFocus() const
+{
+	return m_focus;
+}
+
+sf::Time ScriptedInput::getTime() const
+{
+	return m_time;
+}
+
+////////////////////////////////////////////////////////////
+// RecordedInput
+////////////////////////////////////////////////////////////
+
+RecordedInput::RecordedInput(const std::vector<InputFrame>& frames)
+{
+	setFrames(frames);
+}
+
+void RecordedInput::setFrames(const std::vector<InputFrame>& frames)
+{
+	m_frames = frames;
+	rewind();
+}
+
+void RecordedInput::rewind()
+{
+	m_frame = 0;
+	m_event = 0;
+}
+
+bool RecordedInput::isFinished() const
+{
+	return m_frame >= m_frames.size();
+}
+
+std::size_t RecordedInput::getFrameIndex() const
+{
+	return m_frame;
+}
+
+const std::vector<InputFrame>& RecordedInput::getFrames() const
+{
+	return m_frames;
+}
+
+bool RecordedInput::pollEvent(sf::Event& event)
+{
+	if (isFinished() || m_event >= m_frames[m_frame].events.size())return false;
+
+	event = m_frames[m_frame].events[m_event++];
+	return true;
+}
+
+sf::Vector2i RecordedInput::getMousePosition() const
+{
+	if (m_frames.empty())return sf::Vector2i();
+	return m_frames[std::min(m_frame, m_frames.size() - 1)].mousePosition;
+}
+
+bool RecordedInput::isButtonPressed(sf::Mouse::Button button) const
+{
+	if (m_frames.empty())return false;
+	return (m_frames[std::min(m_frame, m_frames.size() - 1)].buttons >> button) & 1u;
+}
+
+bool RecordedInput::hasFocus() const
+{
+	return !isFinished() && m_frames[m_frame].focus;
+}
+
+sf::Time RecordedInput::getTime() const
+{
+	if (m_frames.empty())return sf::Time::Zero;
+	return m_frames[std::min(m_frame, m_frames.size() - 1)].time;
+}
+
+void RecordedInput::nextFrame()
+{
+	if (isFinished())return;
+
+	m_frame++;
+	m_event = 0;
+}
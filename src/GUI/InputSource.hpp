@@ -0,0 +1,255 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <deque>
+#include <vector>
+
+namespace gui {
+
+////////////////////////////////////////////////////////////
+/// \brief Source of events and mouse state read by a Frame
+///
+/// Frame never reads sf::Mouse or a window directly, so it can be driven
+/// by a live window, by a script or by a recorded session.
+///
+////////////////////////////////////////////////////////////
+class InputSource {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Virtual destructor
+	///
+	////////////////////////////////////////////////////////////
+	virtual ~InputSource();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Pop the next pending event
+	///
+	/// \param event -> Event to fill
+	///
+	/// \return true if an event was returned, false if none is pending
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool pollEvent(sf::Event& event) = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the position of the mouse in pixels
+	///
+	////////////////////////////////////////////////////////////
+	virtual sf::Vector2i getMousePosition() const = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if a mouse button is pressed
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool isButtonPressed(sf::Mouse::Button button) const = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if the input is directed to the frame
+	///
+	////////////////////////////////////////////////////////////
+	virtual bool hasFocus() const = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the time of the source, used to timestamp samples
+	///
+	////////////////////////////////////////////////////////////
+	virtual sf::Time getTime() const = 0;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Called by the frame at the end of each update
+	///
+	////////////////////////////////////////////////////////////
+	virtual void nextFrame();
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Input read from a live window and the system mouse
+///
+////////////////////////////////////////////////////////////
+class WindowInput : public InputSource {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor, input without window has no focus
+	///
+	////////////////////////////////////////////////////////////
+	WindowInput();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the window to read from
+	///
+	////////////////////////////////////////////////////////////
+	void setWindow(sf::Window& window);
+
+	bool pollEvent(sf::Event& event) override;
+	sf::Vector2i getMousePosition() const override;
+	bool isButtonPressed(sf::Mouse::Button button) const override;
+	bool hasFocus() const override;
+	sf::Time getTime() const override;
+
+private:
+	sf::Window* m_window;		/// < window to read from
+	sf::Clock m_clock;			/// < time since construction
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Input made of events pushed by the program
+///
+/// The mouse follows the mouse events as they are polled, so the
+/// state seen by the frame matches the event stream. Time only
+/// advances when asked to, which keeps runs deterministic.
+///
+////////////////////////////////////////////////////////////
+class ScriptedInput : public InputSource {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor, input has focus
+	///
+	////////////////////////////////////////////////////////////
+	ScriptedInput();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Append an event to the pending events
+	///
+	////////////////////////////////////////////////////////////
+	void pushEvent(const sf::Event& event);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Push a mouse moved event
+	///
+	/// \param x -> X position in pixels
+	/// \param y -> Y position in pixels
+	///
+	////////////////////////////////////////////////////////////
+	void moveMouse(int x, int y);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Push a mouse button pressed event at the current mouse position
+	///
+	////////////////////////////////////////////////////////////
+	void pressButton(sf::Mouse::Button button = sf::Mouse::Left);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Push a mouse button released event at the current mouse position
+	///
+	////////////////////////////////////////////////////////////
+	void releaseButton(sf::Mouse::Button button = sf::Mouse::Left);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Push a vertical mouse wheel event at the current mouse position
+	///
+	////////////////////////////////////////////////////////////
+	void scrollWheel(float delta);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Push a text entered event
+	///
+	////////////////////////////////////////////////////////////
+	void enterText(sf::Uint32 unicode);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set whether the input has focus
+	///
+	////////////////////////////////////////////////////////////
+	void setFocus(bool focus);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Advance the time of the source
+	///
+	////////////////////////////////////////////////////////////
+	void advanceTime(sf::Time time);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of events not polled yet
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getPendingEventCount() const;
+
+	bool pollEvent(sf::Event& event) override;
+	sf::Vector2i getMousePosition() const override;
+	bool isButtonPressed(sf::Mouse::Button button) const override;
+	bool hasFocus() const override;
+	sf::Time getTime() const override;
+
+private:
+	std::deque<sf::Event> m_events;		/// < pending events
+	sf::Vector2i m_pushedPosition;		/// < mouse position after the last pushed event
+	sf::Vector2i m_position;			/// < mouse position after the last polled event
+	unsigned int m_buttons;				/// < bit n is set if sf::Mouse::Button(n) is pressed
+	bool m_focus;						/// < whether the input has focus
+	sf::Time m_time;					/// < current time
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Input of one frame of a recorded session
+///
+////////////////////////////////////////////////////////////
+struct InputFrame {
+	std::vector<sf::Event> events;	/// < events polled during the frame
+	sf::Vector2i mousePosition;		/// < mouse position sampled by the update
+	unsigned int buttons;			/// < bit n is set if sf::Mouse::Button(n) is pressed
+	bool focus;						/// < whether the input had focus
+	sf::Time time;					/// < time of the update
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Input replaying recorded frames one update at a time
+///
+////////////////////////////////////////////////////////////
+class RecordedInput : public InputSource {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param frames -> Recorded frames, in order
+	///
+	////////////////////////////////////////////////////////////
+	RecordedInput(const std::vector<InputFrame>& frames = std::vector<InputFrame>());
+
+	////////////////////////////////////////////////////////////
+	/// \brief Replace the recorded frames and restart
+	///
+	////////////////////////////////////////////////////////////
+	void setFrames(const std::vector<InputFrame>& frames);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Start again from the first frame
+	///
+	////////////////////////////////////////////////////////////
+	void rewind();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if every frame has been replayed
+	///
+	////////////////////////////////////////////////////////////
+	bool isFinished() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the index of the frame being replayed
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getFrameIndex() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the recorded frames
+	///
+	////////////////////////////////////////////////////////////
+	const std::vector<InputFrame>& getFrames() const;
+
+	bool pollEvent(sf::Event& event) override;
+	sf::Vector2i getMousePosition() const override;
+	bool isButtonPressed(sf::Mouse::Button button) const override;
+	bool hasFocus() const override;
+	sf::Time getTime() const override;
+	void nextFrame() override;
+
+private:
+	std::vector<InputFrame> m_frames;	/// < recorded frames
+	std::size_t m_frame;				/// < index of the frame being replayed
+	std::size_t m_event;				/// < index of the next event of the frame
+};
+
+} // namespace gui
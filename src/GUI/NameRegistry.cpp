@@ -0,0 +1,95 @@
+#include "NameRegistry.hpp"
+#include "GUIFrame.hpp"
+
+using namespace gui;
+
+static const std::string noName;
+
+void NameRegistry::set(const Entity& entity, const Name& name)
+{
+	Atom atom = intern(name);
+
+	// the name moves from its previous entity and the entity loses its previous name
+	unbind(atom);
+	remove(entity.getID());
+
+	m_bindings[atom] = { entity.getID(), entity.getHandle() };
+	m_atomsByID[entity.getID()] = atom;
+}
+
+void NameRegistry::remove(const Name& name)
+{
+	Atom atom = find(name);
+	if (atom != noAtom)unbind(atom);
+}
+
+void NameRegistry::remove(unsigned long long id)
+{
+	auto it = m_atomsByID.find(id);
+	if (it != m_atomsByID.end())unbind(it->second);
+}
+
+unsigned long long NameRegistry::getID(const Name& name) const
+{
+	Atom atom = find(name);
+	if (atom == noAtom)return 0;
+
+	const Binding& binding = m_bindings[atom];
+	return Entity::get(binding.handle) != nullptr ? binding.id : 0;
+}
+
+const std::string& NameRegistry::getName(unsigned long long id) const
+{
+	auto it = m_atomsByID.find(id);
+	if (it == m_atomsByID.end())return noName;
+
+	// a destroyed entity may have left its Id to a new one
+	return Entity::get(m_bindings[it->second].handle) != nullptr ? m_atoms[it->second] : noName;
+}
+
+std::size_t NameRegistry::getSize() const
+{
+	return m_atomsByID.size();
+}
+
+void NameRegistry::prune()
+{
+	for (auto it = m_atomsByID.begin(); it != m_atomsByID.end();) {
+		if (Entity::get(m_bindings[it->second].handle) == nullptr) {
+			m_bindings[it->second] = { 0, Handle() };
+			it = m_atomsByID.erase(it);
+		}
+		else it++;
+	}
+}
+
+NameRegistry::Atom NameRegistry::intern(const Name& name)
+{
+	Atom atom = find(name);
+	if (atom != noAtom)return atom;
+
+	atom = (Atom)m_atoms.size();
+	m_atoms.emplace_back(name.text);
+	m_atomsByHash.emplace(name.hash, atom);
+	m_bindings.push_back({ 0, Handle() });
+	return atom;
+}
+
+NameRegistry::Atom NameRegistry::find(const Name& name) const
+{
+	// different names rarely share a hash, the text decides
+	auto range = m_atomsByHash.equal_range(name.hash);
+	for (auto it = range.first; it != range.second; it++) {
+		if (m_atoms[it->second] == name.text)return it->second;
+	}
+	return noAtom;
+}
+
+void NameRegistry::unbind(Atom atom)
+{
+	Binding& binding = m_bindings[atom];
+	if (binding.id == 0)return;
+
+	m_atomsByID.erase(binding.id);
+	binding = { 0, Handle() };
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "SlotMap.hpp"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace gui {
+
+class Entity;
+
+////////////////////////////////////////////////////////////
+/// \brief Hash a name, FNV-1a, usable at compile time
+///
+////////////////////////////////////////////////////////////
+constexpr std::uint64_t hashName(std::string_view text)
+{
+	std::uint64_t hash = 14695981039346656037ull;
+	for (char c : text) {
+		hash ^= (unsigned char)c;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Name of an entity together with its hash
+///
+/// Lookups never copy the text. A name declared constexpr is
+/// hashed at compile time :
+/// \code
+/// constexpr gui::Name okName("ok");
+/// gui::Entity* ok = frame.getByName(okName);
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+struct Name {
+	constexpr Name(const char* text) : text(text), hash(hashName(text)) {}
+	constexpr Name(std::string_view text) : text(text), hash(hashName(text)) {}
+	Name(const std::string& text) : Name(std::string_view(text)) {}
+
+	std::string_view text;	/// < characters of the name, not owned
+	std::uint64_t hash;		/// < hashName of text
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Two way map between names and gui Ids
+///
+/// Every name is interned once as an atom, then both directions
+/// are a hash lookup. An entity has at most one name and a name
+/// belongs to at most one entity. Names of destroyed entities are
+/// never returned and are dropped by prune.
+///
+////////////////////////////////////////////////////////////
+class NameRegistry {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Name an entity, replaces its previous name and takes
+	///		   the name from any other entity
+	///
+	////////////////////////////////////////////////////////////
+	void set(const Entity& entity, const Name& name);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove a name from its entity if the name exists
+	///
+	////////////////////////////////////////////////////////////
+	void remove(const Name& name);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove the name of an entity by its Id if it has one
+	///
+	////////////////////////////////////////////////////////////
+	void remove(unsigned long long id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the Id of the entity with a name
+	///
+	/// \return gui Id, 0 if no live entity has the name
+	///
+	////////////////////////////////////////////////////////////
+	unsigned long long getID(const Name& name) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the name of an entity by its Id
+	///
+	/// \return The name if it exists else empty string
+	///
+	////////////////////////////////////////////////////////////
+	const std::string& getName(unsigned long long id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of named entities
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Drop the names of destroyed entities
+	///
+	////////////////////////////////////////////////////////////
+	void prune();
+
+private:
+	typedef unsigned int Atom;
+	static const Atom noAtom = ~0u;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the atom of a name, interning it if needed
+	///
+	////////////////////////////////////////////////////////////
+	Atom intern(const Name& name);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the atom of a name
+	///
+	/// \return Atom of the name, noAtom if it was never interned
+	///
+	////////////////////////////////////////////////////////////
+	Atom find(const Name& name) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Unbind an atom from its entity
+	///
+	////////////////////////////////////////////////////////////
+	void unbind(Atom atom);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Entity owning an atom
+	///
+	////////////////////////////////////////////////////////////
+	struct Binding {
+		unsigned long long id;	/// < gui Id of the entity, 0 if the name is free
+		Handle handle;		/// < handle of the entity, tells if it was destroyed
+	};
+
+	std::deque<std::string> m_atoms;							/// < text of every interned name by atom, a deque keeps the strings in place
+	std::unordered_multimap<std::uint64_t, Atom> m_atomsByHash;	/// < atoms by the hash of their text
+	std::vector<Binding> m_bindings;							/// < entity owning every atom
+	std::unordered_map<unsigned long long, Atom> m_atomsByID;	/// < atom of every named entity by gui Id
+};
+
+} // namespace gui
@@ -11,65 +11,148 @@ Page::Page(const sf::Vector2f& size)
 	m_activeRegion = sf::FloatRect(0, 0, size.x, size.y);
 	m_lastActiveRegion = sf::FloatRect(0, 0, m_maxSize.x, m_maxSize.y);
 	m_background.setSize(size);
+	m_redraw = true;
+	m_themeChangeCount = Theme::getChangeCount();
+	m_nextOrder = 0;
+	m_tombstoneCount = 0;
 
-	for (int i = 0; i < 4; i++)
-		m_connectedScroll[i].setInactive();
-
-	setHeader(false);
+	// header and scrolls are created on first use
 
 	m_functional_object = FunctionalObject::PAGE;
 	
 }
+Page::~Page()
+{
+	// children outliving the page must not report their destruction to it
+	for (const Child& child : m_entities) {
+		if (child.entity != nullptr)setFunctionalParent(*child.entity, nullptr);
+	}
+}
 void Page::addEntity(Entity& entity)
 {
-	m_entities.push_back(&entity);
+	if (m_slots.find(entity.getID()) == m_slots.end()) {
+		m_slots[entity.getID()] = m_entities.size();
+		m_entities.push_back({ &entity, entity.getID(), entity.getHandle() });
+		m_grid.insert(entity, m_nextOrder++);
+	}
 
 	setFunctionalParent(entity, this);
+	requestRedraw(entity);
 }
 void Page::removeEntity(const Entity& entity)
 {
-	std::string name = getName(entity.getID());
-	if (name != "")Frame::removeName(name);
-	for (int i = 0; i < m_entities.size(); i++) {
-		if (m_entities[i]->getID() == entity.getID()) {
-			m_entities.erase(m_entities.begin() + i);
-			break;
-		}
+	Frame* frame = getFrame();
+	if (frame != nullptr)frame->removeName(entity);
+
+	for (std::size_t i = 0; i < m_pendingNames.size(); i++) {
+		if (m_pendingNames[i].handle != entity.getHandle())continue;
+		m_pendingNames.erase(m_pendingNames.begin() + i);
+		break;
 	}
+
+	removeEntity(entity.getID());
 }
-void Page::removeEntity(unsigned int id)
+void Page::removeEntity(unsigned long long id)
 {
-	for (int i = 0; i < m_entities.size(); i++) {
-		if (m_entities[i]->getID() == id) {
-			m_entities.erase(m_entities.begin() + i);
-			break;
-		}
+	// a removed entity no longer reports to the page
+	Entity* entity = getByID(id);
+	if (entity != nullptr && entity->getFunctionalParent() == this)setFunctionalParent(*entity, nullptr);
+
+	detach(id);
+	compactEntities();
+	requestRedraw(*this);
+}
+bool Page::detach(unsigned long long id)
+{
+	// leave a tombstone so other slots stay valid
+	auto slot = m_slots.find(id);
+	if (slot == m_slots.end())return false;
+
+	m_entities[slot->second] = { nullptr, 0, Handle() };
+	m_slots.erase(slot);
+	m_tombstoneCount++;
+	m_grid.remove(id);
+	return true;
+}
+void Page::compactEntities()
+{
+	if (m_tombstoneCount * 2 <= m_entities.size())return;
+
+	std::size_t size = 0;
+	for (std::size_t i = 0; i < m_entities.size(); i++) {
+		if (m_entities[i].entity == nullptr)continue;
+
+		m_entities[size] = m_entities[i];
+		m_slots[m_entities[size].id] = size;
+		size++;
 	}
+	m_entities.resize(size);
+	m_tombstoneCount = 0;
 }
-void Page::setName(const Entity& entity, const std::string& name)
+void Page::detachDestroyed(const Entity& entity)
 {
-	Frame::setName(entity, name);
+	// the frame may hold it as clicked, hovered or named
+	Frame* frame = getFrame();
+	if (frame != nullptr)frame->detachDestroyed(entity);
+
+	if (!detach(entity.getID()))return;
+	compactEntities();
+	requestRedraw(*this);
 }
-Entity* Page::getByID(unsigned int id) const
+void Page::setName(const Entity& entity, const Name& name)
 {
-	for (int i = 0; i < m_entities.size(); i++) {
-		if (m_entities[i]->getID() == id) {
-			return m_entities[i];
-		}
+	Frame* frame = getFrame();
+	if (frame != nullptr) {
+		frame->setName(entity, name);
+		return;
+	}
+
+	// kept until the page is attached, a later name of the entity replaces it
+	for (PendingName& pending : m_pendingNames) {
+		if (pending.handle != entity.getHandle())continue;
+		pending.name = std::string(name.text);
+		return;
+	}
+	m_pendingNames.push_back({ entity.getHandle(), std::string(name.text) });
+}
+void Page::registerPendingNames()
+{
+	Frame* frame = getFrame();
+	if (frame == nullptr)return;
+
+	// entities destroyed in the meantime lose their name
+	for (const PendingName& pending : m_pendingNames) {
+		Entity* entity = Entity::get(pending.handle);
+		if (entity != nullptr)frame->setName(*entity, pending.name);
+	}
+	m_pendingNames.clear();
+
+	// nested pages were attached to this one before it was attached
+	for (const Child& child : m_entities) {
+		if (child.entity != nullptr && getClassID(*child.entity) == GUI_ID_PAGE)((Page*)child.entity)->registerPendingNames();
 	}
-	return nullptr;
 }
-Entity* Page::getByName(const std::string& name) const
+Entity* Page::getByID(unsigned long long id) const
 {
-	return getByID(Frame::getIDByName(name));
+	auto slot = m_slots.find(id);
+	return slot != m_slots.end() ? Entity::get(m_entities[slot->second].handle) : nullptr;
 }
-std::string Page::getName(unsigned int id)
+Entity* Page::getByName(const Name& name) const
 {
-	return Frame::getName(id);
+	Frame* frame = getFrame();
+	return frame != nullptr ? getByID(frame->getIDByName(name)) : nullptr;
+}
+const std::string& Page::getName(unsigned long long id) const
+{
+	static const std::string noName;
+
+	Frame* frame = getFrame();
+	return frame != nullptr ? frame->getName(id) : noName;
 }
 void Page::setFillColor(sf::Color color)
 {
 	m_background.setFillColor(color);
+	requestRedraw(*this);
 }
 sf::Color Page::getFillColor() const
 {
@@ -78,10 +161,12 @@ sf::Color Page::getFillColor() const
 void Page::setTexture(const sf::Texture* texture, bool resetRect)
 {
 	m_background.setTexture(texture, resetRect);
+	requestRedraw(*this);
 }
 void Page::setTextureRect(const sf::IntRect& rect)
 {
 	m_background.setTextureRect(rect);
+	requestRedraw(*this);
 }
 const sf::Texture* gui::Page::getTexture() const
 {
@@ -93,16 +178,20 @@ void Page::setActiveRegion(const sf::FloatRect& region)
 	limitActiveRegion();
 
 	for (int i = 0; i < 4; i++) {
-		if (m_connectedScroll[i].isActive())setScroll(ScrollPlacement(i));
+		if (hasScroll(ScrollPlacement(i)))setScroll(ScrollPlacement(i));
+	}
+
+	if (m_header) {
+		m_header->setPointCount(4);
+		m_header->setPoint(0, sf::Vector2f(0, 0));
+		m_header->setPoint(1, sf::Vector2f(m_activeRegion.width, 0));
+		m_header->setPoint(2, sf::Vector2f(m_activeRegion.width, 15));
+		m_header->setPoint(3, sf::Vector2f(0, 15));
 	}
+	if (m_minimise)m_minimise->setPosition(m_activeRegion.width - 15, -15);
+	if (m_maximise)m_maximise->setPosition(m_activeRegion.width - 33, -15);
 
-	m_header.setPointCount(4);
-	m_header.setPoint(0, sf::Vector2f(0, 0));
-	m_header.setPoint(1, sf::Vector2f(m_activeRegion.width, 0));
-	m_header.setPoint(2, sf::Vector2f(m_activeRegion.width, 15));
-	m_header.setPoint(3, sf::Vector2f(0, 15));
-	m_minimise.setPosition(m_activeRegion.width - 15, -15);
-	m_maximise.setPosition(m_activeRegion.width - 33, -15);
+	requestRedraw(*this);
 }
 sf::FloatRect Page::getActiveRegion() const
 {
@@ -113,18 +202,21 @@ void Page::moveActiveRegion(float offsetX, float offsetY)
 	m_activeRegion.left += offsetX;
 	m_activeRegion.top += offsetY;
 	limitActiveRegion();
+	requestRedraw(*this);
 }
 void Page::moveActiveRegion(const sf::Vector2f& offset)
 {
 	m_activeRegion.left += offset.x;
 	m_activeRegion.top += offset.y;
 	limitActiveRegion();
+	requestRedraw(*this);
 }
 void Page::setMaxSize(const sf::Vector2f& size)
 {
 	m_maxSize = size;
 	m_lastActiveRegion = sf::FloatRect(0, 0, m_maxSize.x, m_maxSize.y);
 	m_background.setSize(getMaxSize());
+	requestRedraw(*this);
 }
 sf::Vector2f Page::getMaxSize() const
 {
@@ -137,9 +229,10 @@ sf::Vector2f Page::getSize() const
 void Page::setScroll(ScrollPlacement place)
 {
 	// construct scroll
-	m_connectedScroll[place].createScroll(getSize(), getMaxSize(), place);
-	m_connectedScroll[place].mapBarPosition(sf::Vector2f(m_activeRegion.left, m_activeRegion.top));
-	m_connectedScroll[place].setActive();
+	Scroll& scroll = getScroll(place);
+	scroll.createScroll(getSize(), getMaxSize(), place);
+	scroll.mapBarPosition(sf::Vector2f(m_activeRegion.left, m_activeRegion.top));
+	scroll.setActive();
 
 	// calculate complementary placement
 	ScrollPlacement comp((ScrollPlacement)(((int)place + 2) % 4));
@@ -151,18 +244,22 @@ void Page::setScroll(ScrollPlacement place)
 		4 - move active region of page by returned offset
 	*/
 
-	m_connectedScroll[place].m_bar.setAction([this, place]() {
+	scroll.m_bar.setAction([this, place]() {
 		scrollBy(place, getLastMouseOffset());
 		});
-	m_connectedScroll[place].m_rect.setAction([this, place, comp]() {
-		sf::Vector2f offset = m_connectedScroll[place].scrollTo(getLocalMousePosition());
-		if (m_connectedScroll[comp].isActive())m_connectedScroll[comp].scrollBy(offset);
-		moveActiveRegion(m_connectedScroll[place].mapPosition(offset));
+	scroll.m_rect.setAction([this, place, comp]() {
+		sf::Vector2f offset = m_connectedScroll[place]->scrollTo(getLocalMousePosition());
+		if (hasScroll(comp))m_connectedScroll[comp]->scrollBy(offset);
+		moveActiveRegion(m_connectedScroll[place]->mapPosition(offset));
 		});
 }
 void Page::removeScroll(ScrollPlacement place)
 {
-	m_connectedScroll[place].setInactive();
+	if (m_connectedScroll[place])m_connectedScroll[place]->setInactive();
+}
+bool Page::hasScroll(ScrollPlacement place) const
+{
+	return m_connectedScroll[place] && m_connectedScroll[place]->isActive();
 }
 void Page::scrollBy(ScrollPlacement place, const sf::Vector2f& offset)
 {
@@ -172,13 +269,13 @@ void Page::scrollBy(ScrollPlacement place, const sf::Vector2f& offset)
 	sf::Vector2f newOffset;
 
 	// scroll by offset and scroll complement by returned offset
-	if (m_connectedScroll[place].isActive()) {
-		newOffset = m_connectedScroll[place].scrollBy(offset);
-		if (m_connectedScroll[comp].isActive())newOffset = m_connectedScroll[comp].scrollBy(newOffset);
+	if (hasScroll(place)) {
+		newOffset = m_connectedScroll[place]->scrollBy(offset);
+		if (hasScroll(comp))newOffset = m_connectedScroll[comp]->scrollBy(newOffset);
 	}
 
-	if (m_connectedScroll[place].isActive())
-		moveActiveRegion(m_connectedScroll[place].mapPosition(newOffset));
+	if (hasScroll(place))
+		moveActiveRegion(m_connectedScroll[place]->mapPosition(newOffset));
 }
 void Page::setHeader(bool hasHeader, bool isMovable, bool isMinimisable, bool isMaximisable)
 {
@@ -198,73 +295,80 @@ void Page::setHeader(bool hasHeader, bool isMovable, bool isMinimisable, bool is
 	*/
 
 	if (hasHeader) {
-		m_header.setPointCount(4);
-		m_header.setPoint(0, sf::Vector2f(0, 0));
-		m_header.setPoint(1, sf::Vector2f(m_activeRegion.width, 0));
-		m_header.setPoint(2, sf::Vector2f(m_activeRegion.width, 15));
-		m_header.setPoint(3, sf::Vector2f(0, 15));
-		m_header.setPosition(0, -15);
-		m_header.setFillColor(sf::Color::White);
-		m_header.setSelectionFillColor(sf::Color::White);
-		m_header.actionEvent = ActionEvent::MOUSEHELD;
-		if (isMovable)m_header.setAction([this] {
+		Button& header = getChrome(m_header);
+		header.setPointCount(4);
+		header.setPoint(0, sf::Vector2f(0, 0));
+		header.setPoint(1, sf::Vector2f(m_activeRegion.width, 0));
+		header.setPoint(2, sf::Vector2f(m_activeRegion.width, 15));
+		header.setPoint(3, sf::Vector2f(0, 15));
+		header.setPosition(0, -15);
+		header.setFillColor(sf::Color::White);
+		header.setSelectionFillColor(sf::Color::White);
+		header.actionEvent = ActionEvent::MOUSEHELD;
+		if (isMovable)header.setAction([this] {
 			move(getFunctionalParent()->getLastMouseOffset());
 			});
-		else m_header.setAction(nullptr);
-		m_header.setActive();
+		else header.setAction(nullptr);
+		header.setActive();
 
 		if (isMinimisable) {
-			m_minimise.setPointCount(4);
-			m_minimise.setPoint(0, sf::Vector2f(0, 0));
-			m_minimise.setPoint(1, sf::Vector2f(15, 0));
-			m_minimise.setPoint(2, sf::Vector2f(15, 15));
-			m_minimise.setPoint(3, sf::Vector2f(0, 15));
-			m_minimise.setPosition(m_activeRegion.width - 15, -15);
-			m_minimise.setFillColor(sf::Color::Red);
-			m_minimise.setSelectionFillColor(sf::Color::Red);
-			m_minimise.setSelectionOutlineColor(sf::Color::Red);
-			m_minimise.setSelectionOutlineThickness(3);
-			m_minimise.actionEvent = ActionEvent::RELEASE;
-			m_minimise.setAction([this] { isActive() ? setInactive() : setActive(); });
-			m_minimise.setActive();
+			Button& minimise = getChrome(m_minimise);
+			minimise.setPointCount(4);
+			minimise.setPoint(0, sf::Vector2f(0, 0));
+			minimise.setPoint(1, sf::Vector2f(15, 0));
+			minimise.setPoint(2, sf::Vector2f(15, 15));
+			minimise.setPoint(3, sf::Vector2f(0, 15));
+			minimise.setPosition(m_activeRegion.width - 15, -15);
+			minimise.setFillColor(sf::Color::Red);
+			minimise.setSelectionFillColor(sf::Color::Red);
+			minimise.setSelectionOutlineColor(sf::Color::Red);
+			minimise.setSelectionOutlineThickness(3);
+			minimise.actionEvent = ActionEvent::RELEASE;
+			minimise.setAction([this] { isActive() ? setInactive() : setActive(); });
+			minimise.setActive();
 		}
-		else {
-			m_minimise.setInactive();
+		else if (m_minimise) {
+			m_minimise->setInactive();
 		}
 
 		if (isMaximisable) {
-			m_maximise.setPointCount(4);
-			m_maximise.setPoint(0, sf::Vector2f(0, 0));
-			m_maximise.setPoint(1, sf::Vector2f(15, 0));
-			m_maximise.setPoint(2, sf::Vector2f(15, 15));
-			m_maximise.setPoint(3, sf::Vector2f(0, 15));
-			m_maximise.setPosition(m_activeRegion.width - 33, -15);
-			m_maximise.setFillColor(sf::Color::Blue);
-			m_maximise.setSelectionFillColor(sf::Color::Blue);
-			m_maximise.setSelectionOutlineColor(sf::Color::Blue);
-			m_maximise.setSelectionOutlineThickness(3);
-			m_maximise.actionEvent = ActionEvent::RELEASE;
-			m_maximise.setAction([this] { 
+			Button& maximise = getChrome(m_maximise);
+			maximise.setPointCount(4);
+			maximise.setPoint(0, sf::Vector2f(0, 0));
+			maximise.setPoint(1, sf::Vector2f(15, 0));
+			maximise.setPoint(2, sf::Vector2f(15, 15));
+			maximise.setPoint(3, sf::Vector2f(0, 15));
+			maximise.setPosition(m_activeRegion.width - 33, -15);
+			maximise.setFillColor(sf::Color::Blue);
+			maximise.setSelectionFillColor(sf::Color::Blue);
+			maximise.setSelectionOutlineColor(sf::Color::Blue);
+			maximise.setSelectionOutlineThickness(3);
+			maximise.actionEvent = ActionEvent::RELEASE;
+			maximise.setAction([this] { 
 				sf::FloatRect rect = m_lastActiveRegion;
 				m_lastActiveRegion = getActiveRegion();
 				setActiveRegion(rect);
 				});
-			m_maximise.setActive();
+			maximise.setActive();
 		}
-		else {
-			m_maximise.setInactive();
+		else if (m_maximise) {
+			m_maximise->setInactive();
 		}
 	}
 	else {
-		m_header.setInactive();
-		m_minimise.setInactive();
-		m_maximise.setInactive();
+		if (m_header)m_header->setInactive();
+		if (m_minimise)m_minimise->setInactive();
+		if (m_maximise)m_maximise->setInactive();
 	}
 }
 sf::Vector2f Page::getLocalMousePosition() const
 {
 	return getInverseTransform().transformPoint(getFunctionalParent()->getMousePosition());
 }
+const Pointer& Page::getPointer() const
+{
+	return getFunctionalParent()->getPointer();
+}
 sf::Vector2f Page::getMousePosition() const
 {
 	return  getInverseTransform().transformPoint(getFunctionalParent()->getMousePosition()) + sf::Vector2f(m_activeRegion.left, m_activeRegion.top);
@@ -284,6 +388,25 @@ sf::FloatRect gui::Page::getGlobalBounds() const
 {
 	return getTransform().transformRect(getLocalBounds());
 }
+sf::FloatRect Page::getDrawBounds() const
+{
+	sf::FloatRect bounds;
+
+	if (isActive()) {
+		bounds = getLocalBounds();
+		for (int i = 0; i < 4; i++) {
+			if (hasScroll(ScrollPlacement(i)))bounds = uniteRects(bounds, m_connectedScroll[i]->getDrawBounds());
+		}
+	}
+
+	if (hasHeader()) {
+		bounds = uniteRects(bounds, m_header->getDrawBounds());
+		if (m_minimise && m_minimise->isActive())bounds = uniteRects(bounds, m_minimise->getDrawBounds());
+		if (m_maximise && m_maximise->isActive())bounds = uniteRects(bounds, m_maximise->getDrawBounds());
+	}
+
+	return getTransform().transformRect(bounds);
+}
 bool Page::contains(const sf::Vector2f& point) const
 {
 	return getLocalBounds().contains(getInverseTransform().transformPoint(point));
@@ -295,14 +418,14 @@ Entity* Page::isHit(const sf::Vector2f& point)
 	sf::Vector2f inv_trans_point = getInverseTransform().transformPoint(point);
 
 	// check for m_header and minimise and maximise
-	if (m_header.isActive()) {
-		entity = m_minimise.isHit(inv_trans_point);
+	if (hasHeader()) {
+		if (m_minimise)entity = m_minimise->isHit(inv_trans_point);
 		if (entity != nullptr)return entity;
 
-		entity = m_maximise.isHit(inv_trans_point);
+		if (m_maximise)entity = m_maximise->isHit(inv_trans_point);
 		if (entity != nullptr)return entity;
 
-		entity = m_header.isHit(inv_trans_point);
+		entity = m_header->isHit(inv_trans_point);
 		if (entity != nullptr)return entity;	
 	}
 
@@ -313,12 +436,14 @@ Entity* Page::isHit(const sf::Vector2f& point)
 
 		// if point is in one of he scrolls
 		for (int i = 0; i < 4 && entity == nullptr; i++) {
-			if (m_connectedScroll[i].isActive())entity = m_connectedScroll[i].isHit(inv_trans_point);
+			if (hasScroll(ScrollPlacement(i)))entity = m_connectedScroll[i]->isHit(inv_trans_point);
 		}
 
-		// if point is in any entity
-		for (auto it = m_entities.begin(); it != m_entities.end() && entity == nullptr; it++) {
-			entity = (*it)->isHit(inv_trans_point + sf::Vector2f(m_activeRegion.left, m_activeRegion.top));
+		// if point is in any entity, only entities whose bounds contain the point are tested
+		sf::Vector2f region_point = inv_trans_point + sf::Vector2f(m_activeRegion.left, m_activeRegion.top);
+		m_grid.query(region_point, m_found);
+		for (auto it = m_found.rbegin(); it != m_found.rend() && entity == nullptr; it++) {
+			entity = (*it)->isHit(region_point);
 		}
 
 		// else point is in page
@@ -329,42 +454,37 @@ Entity* Page::isHit(const sf::Vector2f& point)
 	}
 	return nullptr;
 }
-void Page::draw(sf::RenderTarget& target, sf::RenderStates states) const
+void Page::submit(RenderBatch& batch, sf::RenderStates states) const
 {
+	GUI_TRACE_ENTITY("Page::draw", *this);
+
 	states.transform *= getTransform();
 
 	if (isActive()) {
 
 		// x or y attribute of maxSize is zero then error if thrown
 		if (m_maxSize.x && m_maxSize.y) {
-			sf::RenderTexture rt;
-			rt.create(getSize().x, getSize().y);
-			rt.clear(sf::Color::Transparent);
-
-			rt.draw(m_background);
+			updateSurface(batch);
 
-			for (auto it = m_entities.begin(); it != m_entities.end(); it++) {
-				(*it)->move(-sf::Vector2f(m_activeRegion.left, m_activeRegion.top));
-				(*it)->draw(rt);
-				(*it)->move(sf::Vector2f(m_activeRegion.left, m_activeRegion.top));
-			}
-			rt.display();
+			// the surface holds premultiplied colors
 			sf::Sprite s;
-			s.setTexture(rt.getTexture());
-			target.draw(s, states);
+			s.setTexture(m_surface.getTexture());
+			sf::RenderStates surfaceStates(states);
+			surfaceStates.blendMode = RenderBatch::BlendPremultiplied;
+			batch.add(s, surfaceStates);
 		}
 
 		for (int i = 0; i < 4; i++) {
-			if (m_connectedScroll[i].isActive()) {
-				m_connectedScroll[i].draw(target, states);
+			if (hasScroll(ScrollPlacement(i))) {
+				m_connectedScroll[i]->submit(batch, states);
 			}
 		}
 	}
 
-	if (m_header.isActive()) {
-		m_header.draw(target, states);
-		m_minimise.draw(target, states);
-		m_maximise.draw(target, states);
+	if (hasHeader()) {
+		m_header->submit(batch, states);
+		if (m_minimise)m_minimise->submit(batch, states);
+		if (m_maximise)m_maximise->submit(batch, states);
 	}
 }
 void Page::activateSelection()
@@ -375,28 +495,77 @@ void Page::deactivateSelection()
 {
 	m_selected = false;
 }
+void Page::updateSurface(RenderBatch& batch) const
+{
+	sf::Vector2u size(getSize());
+
+	// surface of size zero cannot be created
+	if (size.x == 0 || size.y == 0)return;
+
+	// recreate only if size of active region has changed
+	if (m_surface.getSize() != size) {
+		m_surface.create(size.x, size.y);
+		batch.countSurface();
+		m_redraw = true;
+	}
+
+	// a swapped theme may restyle any child
+	if (m_themeChangeCount != Theme::getChangeCount()) {
+		m_themeChangeCount = Theme::getChangeCount();
+		m_redraw = true;
+	}
+
+	// last frame is still valid
+	if (!m_redraw)return;
+
+	m_surface.clear(sf::Color::Transparent);
+
+	batch.pushTarget(m_surface);
+	batch.add(m_background);
+
+	// active region is scrolled through the states, entities are never touched while drawing
+	sf::RenderStates states;
+	states.transform.translate(-m_activeRegion.left, -m_activeRegion.top);
+
+	// entities outside of the active region are not drawn
+	m_grid.query(m_activeRegion, m_found);
+	for (auto it = m_found.begin(); it != m_found.end(); it++) {
+		GUI_TRACE_ENTITY("draw", **it);
+		RenderBatch::EntityScope scope(batch, (*it)->getID());
+		GUI_TRACK_CLASS(**it);
+		(*it)->submit(batch, states);
+	}
+
+	batch.popTarget();
+	m_surface.display();
+
+	m_redraw = false;
+}
 bool Page::pollEvents(sf::Event event)
 {
 	bool wasEventPolled = false;
 	if (isActive()) {
-		for (int i = 0; i < m_entities.size(); i++) {
-			if (getClassID(*m_entities[i]) == GUI_ID_PAGE && m_entities[i]->contains(getMousePosition()))
-				wasEventPolled = ((Page*)m_entities[i])->pollEvents(event);
-			else if (getClassID(*m_entities[i]) == GUI_ID_DROPDOWN && ((Dropdown*)m_entities[i])->containsExcludingHeader(getMousePosition()))
-				wasEventPolled = ((Dropdown*)m_entities[i])->pollEvents(event);
+		for (std::size_t i = 0; i < m_entities.size(); i++) {
+			Entity* entity = m_entities[i].entity;
+			if (entity == nullptr)continue;
+
+			if (getClassID(*entity) == GUI_ID_PAGE && entity->contains(getMousePosition()))
+				wasEventPolled = ((Page*)entity)->pollEvents(event);
+			else if (getClassID(*entity) == GUI_ID_DROPDOWN && ((Dropdown*)entity)->containsExcludingHeader(getMousePosition()))
+				wasEventPolled = ((Dropdown*)entity)->pollEvents(event);
 		}
 
 		if (event.type == sf::Event::MouseWheelScrolled && !wasEventPolled) {
 			if (event.mouseWheelScroll.wheel == sf::Mouse::HorizontalWheel) {
-				if (m_connectedScroll[TOP].isActive())
+				if (hasScroll(TOP))
 					this->scrollBy(TOP, sf::Vector2f(-5 * event.mouseWheelScroll.delta, 0));
-				else if (m_connectedScroll[BOTTOM].isActive())
+				else if (hasScroll(BOTTOM))
 					this->scrollBy(BOTTOM, sf::Vector2f(-5 * event.mouseWheelScroll.delta, 0));
 			}
 			else {
-				if (m_connectedScroll[LEFT].isActive())
+				if (hasScroll(LEFT))
 					this->scrollBy(LEFT, sf::Vector2f(0, -5 * event.mouseWheelScroll.delta));
-				else if (m_connectedScroll[RIGHT].isActive())
+				else if (hasScroll(RIGHT))
 					this->scrollBy(RIGHT, sf::Vector2f(0, -5 * event.mouseWheelScroll.delta));
 			}
 			return true;
@@ -404,6 +573,14 @@ bool Page::pollEvents(sf::Event event)
 	}
 	return wasEventPolled;
 }
+void Page::requestRedraw(const Entity& entity)
+{
+	m_redraw = true;
+	m_grid.invalidate(entity.getID());
+
+	// surface of the page is drawn on the functional parent
+	invalidate();
+}
 void Page::limitActiveRegion()
 {
 	// left and top must not be negative or exceed the maxSize
@@ -422,13 +599,45 @@ void Page::limitActiveRegion()
 
 void Page::setFunctionalParentForSubVariables(Functional* parent)
 {
-	setFunctionalParent(m_header, parent);
-	setFunctionalParent(m_minimise, parent);
-	setFunctionalParent(m_maximise, parent);
+	if (m_header)setFunctionalParent(*m_header, parent);
+	if (m_minimise)setFunctionalParent(*m_minimise, parent);
+	if (m_maximise)setFunctionalParent(*m_maximise, parent);
 	for (int i = 0; i < 4; i++) {
-		setFunctionalParent(m_connectedScroll[i].m_rect, parent);
-		setFunctionalParent(m_connectedScroll[i].m_bar, parent);
+		if (!m_connectedScroll[i])continue;
+		setFunctionalParent(m_connectedScroll[i]->m_rect, parent);
+		setFunctionalParent(m_connectedScroll[i]->m_bar, parent);
 	}
+
+	// the page may just have been attached to a frame
+	registerPendingNames();
+}
+bool Page::hasHeader() const
+{
+	return m_header && m_header->isActive();
+}
+Page::Scroll& Page::getScroll(ScrollPlacement place)
+{
+	std::unique_ptr<Scroll>& scroll = m_connectedScroll[place];
+	if (scroll)return *scroll;
+
+	// scrolls are drawn as parts of the page and act for its functional parent
+	scroll.reset(new Scroll());
+	setOwner(*scroll, this);
+	setOwner(scroll->m_rect, this);
+	setOwner(scroll->m_bar, this);
+	setFunctionalParent(scroll->m_rect, getFunctionalParent());
+	setFunctionalParent(scroll->m_bar, getFunctionalParent());
+	return *scroll;
+}
+Button& Page::getChrome(std::unique_ptr<Button>& button)
+{
+	if (button)return *button;
+
+	// header buttons are drawn as parts of the page and act for its functional parent
+	button.reset(new Button());
+	setOwner(*button, this);
+	setFunctionalParent(*button, getFunctionalParent());
+	return *button;
 }
 
 
@@ -3,6 +3,9 @@
 #include "Button.hpp"
 #include "Slider.hpp"
 #include "GUIFrame.hpp"
+#include "SpatialGrid.hpp"
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace gui {
@@ -25,6 +28,12 @@ public:
 	////////////////////////////////////////////////////////////
 	Page(const sf::Vector2f& size = sf::Vector2f(0, 0));
 
+	////////////////////////////////////////////////////////////
+	/// \brief Destructor, children outliving the page are detached
+	///
+	////////////////////////////////////////////////////////////
+	~Page();
+
 	////////////////////////////////////////////////////////////
 	/// \brief Attach any entity to page
 	///
@@ -41,17 +50,19 @@ public:
 	/// \brief remove any already connected entity from page by its Id
 	///
 	////////////////////////////////////////////////////////////
-	void removeEntity(unsigned int id);
+	void removeEntity(unsigned long long id);
 
 	////////////////////////////////////////////////////////////
-	/// \brief Set the name of the entity
-	///		   Note : there can be no duplicate names
+	/// \brief Set the name of the entity in the frame of the page
+	///		   Note : there can be no duplicate names, names set while
+	///		   the page is not attached to a frame are kept and set
+	///		   once it is attached
 	/// 
 	/// \param entity -> Entity whos name has to be added
 	/// \param name -> New name for the entity
 	///
 	////////////////////////////////////////////////////////////
-	void setName(const Entity& entity, const std::string& name);
+	void setName(const Entity& entity, const Name& name);
 
 	////////////////////////////////////////////////////////////
 	/// \brief Get the entity attached to the object by Id
@@ -59,7 +70,7 @@ public:
 	/// \return Pointer to Entity
 	///
 	////////////////////////////////////////////////////////////
-	Entity* getByID(unsigned int id) const;
+	Entity* getByID(unsigned long long id) const;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Get the entity attached to the object by its name if the name exists
@@ -67,15 +78,15 @@ public:
 	/// \return Pointer to Entity
 	///
 	////////////////////////////////////////////////////////////
-	Entity* getByName(const std::string& name) const;
+	Entity* getByName(const Name& name) const;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Get the name of the entity by its Id
 	/// 
-	/// \return name of the entity
+	/// \return name of the entity, empty string if it has none
 	///
 	////////////////////////////////////////////////////////////
-	std::string getName(unsigned int id);
+	const std::string& getName(unsigned long long id) const;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Set the background color of the object
@@ -229,6 +240,14 @@ public:
 	////////////////////////////////////////////////////////////
 	void removeScroll(ScrollPlacement place);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Check if a Scroll is set by its position / direction
+	///
+	/// \return true if the scroll is set, false otherwise
+	///
+	////////////////////////////////////////////////////////////
+	bool hasScroll(ScrollPlacement place) const;
+
 	////////////////////////////////////////////////////////////
 	/// \brief scroll the object by offset in specified diretion
 	/// 
@@ -258,12 +277,34 @@ public:
 	////////////////////////////////////////////////////////////
 	bool pollEvents(sf::Event event) override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Notify the object that one of its entities has changed
+	///		   and has to be drawn again
+	/// 
+	/// \param entity -> Entity which has changed
+	/// 
+	////////////////////////////////////////////////////////////
+	void requestRedraw(const Entity& entity) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Detach a child as it is destroyed, the frame forgets
+	///		   it if it was clicked, hovered or named
+	///
+	////////////////////////////////////////////////////////////
+	void detachDestroyed(const Entity& entity) override;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Get the mouse position with respect to the current page
 	/// 
 	////////////////////////////////////////////////////////////
 	sf::Vector2f getLocalMousePosition() const;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Get the state of the mouse sampled by the frame
+	/// 
+	////////////////////////////////////////////////////////////
+	const Pointer& getPointer() const override;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Get the mouse position with respect to the active region of current page
 	/// 
@@ -300,13 +341,22 @@ public:
 	Entity* isHit(const sf::Vector2f& point) override;
 
 	////////////////////////////////////////////////////////////
-	/// \brief Draws the object to the target applying its states
+	/// \brief Get the rectangle covered by everything the object draws
+	///
+	/// \return Bounding rectangle of the drawn object in the coordinate
+	///			system of the functional parent
+	///
+	////////////////////////////////////////////////////////////
+	sf::FloatRect getDrawBounds() const override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the geometry of the object to the batch applying its states
 	/// 
-	/// \param target -> Render target to draw to
+	/// \param batch -> Batch collecting the geometry
 	/// \param states -> Current render states
 	/// 
 	////////////////////////////////////////////////////////////
-	void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const override;
+	void submit(RenderBatch& batch, sf::RenderStates states = sf::RenderStates::Default) const override;
 
 	////////////////////////////////////////////////////////////
 	/// \brief Actions to take upon selection of the object
@@ -333,12 +383,65 @@ private:
 	////////////////////////////////////////////////////////////
 	virtual void limitActiveRegion();
 
+	////////////////////////////////////////////////////////////
+	/// \brief Recreate the surface if the size of active region has changed
+	///		   and draw the background and entities on it if anything has changed
+	///
+	/// \param batch -> Batch collecting the geometry, its target is restored afterwards
+	///
+	////////////////////////////////////////////////////////////
+	void updateSurface(RenderBatch& batch) const;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Set the Functional parent of entity's sub variables
 	///
 	////////////////////////////////////////////////////////////
 	void setFunctionalParentForSubVariables(Functional* parent) override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Detach an entity by Id without touching the entity,
+	///		   leaves a tombstone in the list of entities
+	///
+	/// \return true if the entity was attached
+	///
+	////////////////////////////////////////////////////////////
+	bool detach(unsigned long long id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove the tombstones of the list of entities if they
+	///		   take more than half of it, keeping the order of entities
+	///
+	////////////////////////////////////////////////////////////
+	void compactEntities();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the names kept while the page was not attached to a
+	///		   frame, including those of nested pages
+	///
+	/// Does nothing until the page is attached to a frame
+	///
+	////////////////////////////////////////////////////////////
+	void registerPendingNames();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Slot of the list of entities
+	///
+	////////////////////////////////////////////////////////////
+	struct Child {
+		Entity* entity;		/// < attached entity, nullptr if the slot is a tombstone
+		unsigned long long id;	/// < gui Id of the entity, still readable once the entity is destroyed
+		Handle handle;		/// < handle of the entity, invalid once the entity is destroyed
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Name set while the page was not attached to a frame
+	///
+	////////////////////////////////////////////////////////////
+	struct PendingName {
+		Handle handle;		/// < handle of the named entity, its name is dropped once it is destroyed
+		std::string name;	/// < copy of the name, names do not own their text
+	};
+
 	
 	////////////////////////////////////////////////////////////
 	/// \brief Structure for Scolling
@@ -421,13 +524,19 @@ private:
 		Entity* isHit(const sf::Vector2f& point);
 
 		////////////////////////////////////////////////////////////
-		/// \brief Draws the object to the target applying its states
+		/// \brief Get the rectangle covered by the body and the bar of the scroll
 		/// 
-		/// \param target -> Render target to draw to
+		////////////////////////////////////////////////////////////
+		sf::FloatRect getDrawBounds() const;
+
+		////////////////////////////////////////////////////////////
+		/// \brief Add the geometry of the object to the batch applying its states
+		/// 
+		/// \param batch -> Batch collecting the geometry
 		/// \param states -> Current render states
 		/// 
 		////////////////////////////////////////////////////////////
-		void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const;
+		void submit(RenderBatch& batch, sf::RenderStates states = sf::RenderStates::Default) const;
 
 		////////////////////////////////////////////////////////////
 		/// \brief Actions to take upon selection of the object
@@ -453,6 +562,26 @@ private:
 		ScrollPlacement m_place;			/// < placement of scroll
 	};
 
+	////////////////////////////////////////////////////////////
+	/// \brief Check if the header is set
+	///
+	////////////////////////////////////////////////////////////
+	bool hasHeader() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the scroll of a placement, created on first use
+	///
+	////////////////////////////////////////////////////////////
+	Scroll& getScroll(ScrollPlacement place);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a button of the header, created on first use
+	///
+	/// \param button -> m_header, m_minimise or m_maximise
+	///
+	////////////////////////////////////////////////////////////
+	Button& getChrome(std::unique_ptr<Button>& button);
+
 	////////////////////////////////////////////////////////////
 	// Member Data 
 	////////////////////////////////////////////////////////////
@@ -461,15 +590,25 @@ private:
 	sf::Vector2f m_maxSize;					/// < maximum size of the page
 	sf::FloatRect m_activeRegion;			/// < active region of the page
 
-	std::vector<Entity*> m_entities;		/// < list of all entities connected to page
+	std::vector<Child> m_entities;							/// < entities in the order they were attached, removed entities leave tombstones
+	std::vector<PendingName> m_pendingNames;				/// < names set while not attached to a frame, set on the frame once attached
+	std::unordered_map<unsigned long long, std::size_t> m_slots;	/// < maps gui Ids to their slot in m_entities
+	std::size_t m_tombstoneCount;							/// < number of tombstones in m_entities
+	mutable SpatialGrid m_grid;								/// < entities indexed by their draw bounds
+	unsigned int m_nextOrder;								/// < stacking order of the next added entity
+	mutable std::vector<Entity*> m_found;					/// < reused storage for queries of m_grid
 
-	Scroll m_connectedScroll[4];			/// < list of connected scrolls
+	std::unique_ptr<Scroll> m_connectedScroll[4];	/// < list of connected scrolls, nullptr until first set
 
-	Button m_header;						/// < header of the page
-	Button m_minimise;						/// < minimise button for the page
-	Button m_maximise;						/// < maximise button for the page
+	std::unique_ptr<Button> m_header;		/// < header of the page, nullptr until first set
+	std::unique_ptr<Button> m_minimise;		/// < minimise button for the page, nullptr until first set
+	std::unique_ptr<Button> m_maximise;		/// < maximise button for the page, nullptr until first set
 	sf::FloatRect m_lastActiveRegion;		/// < stores the last active region for m_maximise
 	sf::RectangleShape m_background;		/// < background of the page
+
+	mutable sf::RenderTexture m_surface;	/// < offscreen surface holding the last drawn active region
+	mutable bool m_redraw;					/// < whether the surface has to be drawn again
+	mutable unsigned long long m_themeChangeCount;	/// < swaps of themes seen by the last redraw of the surface
 };
 
 } // namespace gui
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+using namespace gui;
+
+////////////////////////////////////////////////////////////
+// Profiler
+////////////////////////////////////////////////////////////
+
+Profiler::ScopedTimer::ScopedTimer(Profiler& profiler, Phase phase) : m_profiler(profiler)
+{
+	m_phase = phase;
+	m_start = std::chrono::steady_clock::now();
+}
+
+Profiler::ScopedTimer::~ScopedTimer()
+{
+	auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start);
+	m_profiler.addTime(m_phase, sf::microseconds(elapsed.count()));
+}
+
+Profiler::FrameScope::FrameScope(Profiler& profiler) : m_profiler(profiler)
+{
+
+}
+
+Profiler::FrameScope::~FrameScope()
+{
+	m_profiler.nextFrame();
+}
+
+Profiler::Profiler(std::size_t history)
+{
+	m_history = std::max<std::size_t>(1, history);
+	for (int i = 0; i < PHASE_COUNT; i++) {
+		m_samples[i].reserve(m_history);
+		m_current[i] = 0;
+		m_last[i] = 0;
+	}
+	m_visited = 0;
+	m_lastVisited = 0;
+	m_drawCalls = 0;
+	m_lastDrawCalls = 0;
+	m_frameCount = 0;
+}
+
+void Profiler::addTime(Phase phase, sf::Time time)
+{
+	m_current[phase] += time.asMicroseconds();
+}
+
+void Profiler::countVisited(unsigned int count)
+{
+	m_visited += count;
+}
+
+void Profiler::countDrawCalls(unsigned int count)
+{
+	m_drawCalls += count;
+}
+
+void Profiler::nextFrame()
+{
+	for (int i = 0; i < PHASE_COUNT; i++) {
+		// oldest sample is overwritten once the history is full
+		if (m_samples[i].size() < m_history)m_samples[i].push_back(m_current[i]);
+		else m_samples[i][m_frameCount % m_history] = m_current[i];
+
+		m_last[i] = m_current[i];
+		m_current[i] = 0;
+	}
+	m_lastVisited = m_visited;
+	m_lastDrawCalls = m_drawCalls;
+	m_visited = 0;
+	m_drawCalls = 0;
+	m_frameCount++;
+}
+
+sf::Time Profiler::getLast(Phase phase) const
+{
+	return sf::microseconds(m_last[phase]);
+}
+
+sf::Time Profiler::getPercentile(Phase phase, float percentile) const
+{
+	if (m_samples[phase].empty())return sf::Time::Zero;
+
+	std::vector<sf::Int64> sorted = m_samples[phase];
+	std::size_t n = (std::size_t)(std::max(0.f, std::min(1.f, percentile)) * (sorted.size() - 1) + 0.5f);
+	std::nth_element(sorted.begin(), sorted.begin() + n, sorted.end());
+	return sf::microseconds(sorted[n]);
+}
+
+unsigned int Profiler::getVisitedCount() const
+{
+	return m_lastVisited;
+}
+
+unsigned int Profiler::getDrawCallCount() const
+{
+	return m_lastDrawCalls;
+}
+
+unsigned long long Profiler::getFrameCount() const
+{
+	return m_frameCount;
+}
+
+const char* Profiler::getPhaseName(Phase phase)
+{
+	switch (phase) {
+	case DISPATCH: return "dispatch";
+	case HIT_TEST: return "hit test";
+	case ACTION: return "action";
+	case ANIMATION: return "animation";
+	case DRAW: return "draw";
+	default: return "";
+	}
+}
+
+////////////////////////////////////////////////////////////
+// ProfilerOverlay
+////////////////////////////////////////////////////////////
+
+ProfilerOverlay::ProfilerOverlay(const Profiler& profiler, const sf::Font& font) : m_profiler(profiler)
+{
+	m_text.setFont(font);
+	m_text.setCharacterSize(14);
+	m_text.setFillColor(sf::Color::White);
+	m_text.setPosition(6, 4);
+	m_background.setFillColor(sf::Color(0, 0, 0, 180));
+}
+
+void ProfilerOverlay::setCharacterSize(unsigned int size)
+{
+	m_text.setCharacterSize(size);
+}
+
+void ProfilerOverlay::update()
+{
+	char line[96];
+	std::string string = "phase        last    p50    p99 (us)\n";
+	for (int i = 0; i < Profiler::PHASE_COUNT; i++) {
+		Profiler::Phase phase = (Profiler::Phase)i;
+		std::snprintf(line, sizeof(line), "%-9s %7lld %6lld %6lld\n", Profiler::getPhaseName(phase),
+			(long long)m_profiler.getLast(phase).asMicroseconds(),
+			(long long)m_profiler.getPercentile(phase, 0.5f).asMicroseconds(),
+			(long long)m_profiler.getPercentile(phase, 0.99f).asMicroseconds());
+		string += line;
+	}
+	std::snprintf(line, sizeof(line), "visited %u  draw calls %u", m_profiler.getVisitedCount(), m_profiler.getDrawCallCount());
+	string += line;
+
+	m_text.setString(string);
+	sf::FloatRect bounds = m_text.getLocalBounds();
+	m_background.setSize({ bounds.left + bounds.width + 12, bounds.top + bounds.height + 12 });
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	states.transform *= getTransform();
+	target.draw(m_background, states);
+	target.draw(m_text, states);
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// Profiling macros
+///
+/// Define GUI_PROFILING to time the phases of gui::Frame. Without it
+/// the macros expand to nothing and Frame holds no profiler.
+///
+////////////////////////////////////////////////////////////
+#ifdef GUI_PROFILING
+#define GUI_PROFILE_CONCAT_IMPL(a, b) a##b
+#define GUI_PROFILE_CONCAT(a, b) GUI_PROFILE_CONCAT_IMPL(a, b)
+#define GUI_PROFILE_SCOPE(profiler, phase) gui::Profiler::ScopedTimer GUI_PROFILE_CONCAT(guiProfileScope, __LINE__)(profiler, gui::Profiler::phase)
+#define GUI_PROFILE_FRAME(profiler) gui::Profiler::FrameScope GUI_PROFILE_CONCAT(guiProfileFrame, __LINE__)(profiler)
+#define GUI_PROFILE_VISIT(profiler, count) (profiler).countVisited(count)
+#define GUI_PROFILE_DRAW_CALLS(profiler, count) (profiler).countDrawCalls(count)
+#else
+#define GUI_PROFILE_SCOPE(profiler, phase)
+#define GUI_PROFILE_FRAME(profiler)
+#define GUI_PROFILE_VISIT(profiler, count) ((void)0)
+#define GUI_PROFILE_DRAW_CALLS(profiler, count) ((void)0)
+#endif
+
+namespace gui {
+
+////////////////////////////////////////////////////////////
+/// \brief Rolling timings of the phases of a frame
+///
+/// Time spent in each phase is summed over a frame, the sums of the
+/// last frames are kept to compute percentiles. Phases may nest,
+/// actions called during event dispatch count in both phases.
+///
+////////////////////////////////////////////////////////////
+class Profiler {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Enumeration of the timed phases
+	///
+	////////////////////////////////////////////////////////////
+	enum Phase { DISPATCH, HIT_TEST, ACTION, ANIMATION, DRAW, PHASE_COUNT };
+
+	////////////////////////////////////////////////////////////
+	/// \brief Times a phase from construction to destruction
+	///
+	////////////////////////////////////////////////////////////
+	class ScopedTimer {
+	public:
+		ScopedTimer(Profiler& profiler, Phase phase);
+		~ScopedTimer();
+
+	private:
+		Profiler& m_profiler;							/// < profiler receiving the time
+		Phase m_phase;									/// < timed phase
+		std::chrono::steady_clock::time_point m_start;	/// < time of construction
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Ends the frame of the profiler on destruction
+	///
+	////////////////////////////////////////////////////////////
+	class FrameScope {
+	public:
+		FrameScope(Profiler& profiler);
+		~FrameScope();
+
+	private:
+		Profiler& m_profiler;	/// < profiler whose frame ends
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param history -> Number of frames kept for percentiles
+	///
+	////////////////////////////////////////////////////////////
+	Profiler(std::size_t history = 120);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add time spent in a phase during the current frame
+	///
+	////////////////////////////////////////////////////////////
+	void addTime(Phase phase, sf::Time time);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add entities visited by hit tests or drawing during the current frame
+	///
+	////////////////////////////////////////////////////////////
+	void countVisited(unsigned int count);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add draw calls issued during the current frame
+	///
+	////////////////////////////////////////////////////////////
+	void countDrawCalls(unsigned int count);
+
+	////////////////////////////////////////////////////////////
+	/// \brief End the current frame and start a new one
+	///
+	////////////////////////////////////////////////////////////
+	void nextFrame();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the time spent in a phase during the last ended frame
+	///
+	////////////////////////////////////////////////////////////
+	sf::Time getLast(Phase phase) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a percentile of the time spent in a phase over the kept frames
+	///
+	/// \param phase -> Timed phase
+	/// \param percentile -> Between 0 and 1, 0.5 for the median
+	///
+	////////////////////////////////////////////////////////////
+	sf::Time getPercentile(Phase phase, float percentile) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of entities visited during the last ended frame
+	///
+	////////////////////////////////////////////////////////////
+	unsigned int getVisitedCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of draw calls issued during the last ended frame
+	///
+	////////////////////////////////////////////////////////////
+	unsigned int getDrawCallCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of ended frames
+	///
+	////////////////////////////////////////////////////////////
+	unsigned long long getFrameCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the display name of a phase
+	///
+	////////////////////////////////////////////////////////////
+	static const char* getPhaseName(Phase phase);
+
+private:
+	std::size_t m_history;								/// < number of frames kept
+	std::vector<sf::Int64> m_samples[PHASE_COUNT];		/// < microseconds per kept frame, ring buffers
+	sf::Int64 m_current[PHASE_COUNT];					/// < microseconds of the current frame
+	sf::Int64 m_last[PHASE_COUNT];						/// < microseconds of the last ended frame
+	unsigned int m_visited;								/// < entities visited in the current frame
+	unsigned int m_lastVisited;							/// < entities visited in the last ended frame
+	unsigned int m_drawCalls;							/// < draw calls of the current frame
+	unsigned int m_lastDrawCalls;						/// < draw calls of the last ended frame
+	unsigned long long m_frameCount;					/// < number of ended frames
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Overlay showing the numbers of a profiler
+///
+/// Not an entity, it changes every frame and should be drawn
+/// on the window after the frame, above everything else.
+///
+////////////////////////////////////////////////////////////
+class ProfilerOverlay : public sf::Drawable, public sf::Transformable {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param profiler -> Profiler to show, must outlive the overlay
+	/// \param font -> Font of the text, must outlive the overlay
+	///
+	////////////////////////////////////////////////////////////
+	ProfilerOverlay(const Profiler& profiler, const sf::Font& font);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the size of the characters
+	///
+	////////////////////////////////////////////////////////////
+	void setCharacterSize(unsigned int size);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Read the numbers of the profiler, call once per frame before drawing
+	///
+	////////////////////////////////////////////////////////////
+	void update();
+
+private:
+	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+	const Profiler& m_profiler;			/// < profiler shown
+	sf::Text m_text;					/// < formatted numbers
+	sf::RectangleShape m_background;	/// < translucent box behind the text
+};
+
+} // namespace gui
@@ -0,0 +1,460 @@
+#include "RenderBatch.hpp"
+
+#include <cmath>
+
+using namespace gui;
+
+// every font texture reserves a white square of 2x2 pixels at its top left corner
+static const sf::Vector2f whiteTexel(1.f, 1.f);
+
+const sf::BlendMode RenderBatch::BlendPremultiplied(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+
+RenderBatch::RenderBatch()
+{
+	m_texture = nullptr;
+	m_blendMode = sf::BlendAlpha;
+	m_hasWhiteTexel = false;
+	m_untextured = true;
+	m_lastDrawTexture = nullptr;
+	resetStats();
+}
+
+RenderBatch::RenderBatch(sf::RenderTarget& target)
+	:RenderBatch()
+{
+	m_targets.push_back(&target);
+}
+
+void RenderBatch::pushTarget(sf::RenderTarget& target)
+{
+	flush();
+	m_targets.push_back(&target);
+}
+
+void RenderBatch::popTarget()
+{
+	flush();
+	m_targets.pop_back();
+}
+
+sf::RenderTarget& RenderBatch::getTarget() const
+{
+	return *m_targets.back();
+}
+
+void RenderBatch::Mesh::build(const sf::Shape& shape, const sf::Color& fillColor, const sf::Color& outlineColor, float outlineThickness)
+{
+	fill.clear();
+	outline.clear();
+	texture = shape.getTexture();
+	bounds = sf::FloatRect();
+
+	std::size_t count = shape.getPointCount();
+	if (count < 3)return;
+
+	// bounds of the shape without outline, used for texture coordinates
+	sf::Vector2f min = shape.getPoint(0), max = shape.getPoint(0);
+	for (std::size_t i = 1; i < count; i++) {
+		sf::Vector2f point = shape.getPoint(i);
+		min.x = std::min(min.x, point.x);
+		min.y = std::min(min.y, point.y);
+		max.x = std::max(max.x, point.x);
+		max.y = std::max(max.y, point.y);
+	}
+	sf::Vector2f size = max - min;
+	sf::Vector2f center = min + size * 0.5f;
+
+	// fill -> fan of triangles around the center, closed by the first point
+	sf::IntRect rect = shape.getTextureRect();
+	fill.resize(count + 2);
+	for (std::size_t i = 0; i <= count; i++) {
+		sf::Vector2f position = i == 0 ? center : shape.getPoint(i - 1);
+
+		sf::Vector2f texCoords;
+		if (texture != nullptr) {
+			float xratio = size.x > 0 ? (position.x - min.x) / size.x : 0;
+			float yratio = size.y > 0 ? (position.y - min.y) / size.y : 0;
+			texCoords = sf::Vector2f(rect.left + rect.width * xratio, rect.top + rect.height * yratio);
+		}
+		fill[i] = sf::Vertex(position, fillColor, texCoords);
+	}
+	fill[count + 1] = fill[1];
+
+	// outline -> strip of triangles around the points, extruded along the normals
+	if (outlineThickness != 0) {
+		outline.resize(count * 2 + 2);
+		for (std::size_t i = 0; i < count; i++) {
+			sf::Vector2f p0 = shape.getPoint((i + count - 1) % count);
+			sf::Vector2f p1 = shape.getPoint(i);
+			sf::Vector2f p2 = shape.getPoint((i + 1) % count);
+
+			// normals of both segments sharing the point
+			sf::Vector2f n1(p0.y - p1.y, p1.x - p0.x);
+			sf::Vector2f n2(p1.y - p2.y, p2.x - p1.x);
+			float l1 = std::sqrt(n1.x * n1.x + n1.y * n1.y);
+			float l2 = std::sqrt(n2.x * n2.x + n2.y * n2.y);
+			if (l1 != 0)n1 /= l1;
+			if (l2 != 0)n2 /= l2;
+
+			// normals must point outside of the shape
+			if (n1.x * (center.x - p1.x) + n1.y * (center.y - p1.y) > 0)n1 = -n1;
+			if (n2.x * (center.x - p1.x) + n2.y * (center.y - p1.y) > 0)n2 = -n2;
+
+			float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
+			sf::Vector2f normal = (n1 + n2) / factor;
+
+			outline[i * 2] = sf::Vertex(p1, outlineColor);
+			outline[i * 2 + 1] = sf::Vertex(p1 + normal * outlineThickness, outlineColor);
+
+			min.x = std::min(min.x, outline[i * 2 + 1].position.x);
+			min.y = std::min(min.y, outline[i * 2 + 1].position.y);
+			max.x = std::max(max.x, outline[i * 2 + 1].position.x);
+			max.y = std::max(max.y, outline[i * 2 + 1].position.y);
+		}
+		// close the outline
+		outline[count * 2] = outline[0];
+		outline[count * 2 + 1] = outline[1];
+	}
+
+	bounds = sf::FloatRect(min, max - min);
+}
+
+void RenderBatch::add(const sf::Shape& shape, const sf::RenderStates& states)
+{
+	if (states.shader != nullptr) {
+		draw(shape, states);
+		return;
+	}
+
+	m_mesh.build(shape, shape.getFillColor(), shape.getOutlineColor(), shape.getOutlineThickness());
+
+	sf::RenderStates shapeStates(states);
+	shapeStates.transform *= shape.getTransform();
+	add(m_mesh, shapeStates);
+}
+
+void RenderBatch::add(const Mesh& mesh, const sf::RenderStates& states)
+{
+	addMesh(mesh, mesh.fill, states);
+}
+
+void RenderBatch::add(const Mesh& mesh, const sf::Color& fillColor, const sf::RenderStates& states)
+{
+	m_recolored.assign(mesh.fill.begin(), mesh.fill.end());
+	for (std::size_t i = 0; i < m_recolored.size(); i++)m_recolored[i].color = fillColor;
+
+	addMesh(mesh, m_recolored, states);
+}
+
+void RenderBatch::addMesh(const Mesh& mesh, const std::vector<sf::Vertex>& fill, const sf::RenderStates& states)
+{
+	if (fill.empty())return;
+
+	// fully transparent geometry changes nothing when blended
+	bool invisibleFill = fill[0].color.a == 0 && states.blendMode == sf::BlendAlpha;
+	bool invisibleOutline = mesh.outline.empty() || (mesh.outline[0].color.a == 0 && states.blendMode == sf::BlendAlpha);
+
+	sf::RenderStates partStates(states);
+	if (!invisibleFill) {
+		partStates.texture = mesh.texture;
+		add(&fill[0], fill.size(), sf::TriangleFan, partStates);
+	}
+	if (!invisibleOutline) {
+		partStates.texture = nullptr;
+		add(&mesh.outline[0], mesh.outline.size(), sf::TriangleStrip, partStates);
+	}
+}
+
+void RenderBatch::add(const sf::Text& text, const sf::RenderStates& states)
+{
+	const sf::Font* font = text.getFont();
+	if (font == nullptr || text.getString().isEmpty())return;
+
+	// lines and outlines of text are not collected
+	if (states.shader != nullptr || text.getOutlineThickness() != 0 ||
+		(text.getStyle() & (sf::Text::Underlined | sf::Text::StrikeThrough))) {
+		draw(text, states);
+		return;
+	}
+
+	sf::Transform transform = states.transform * text.getTransform();
+
+	unsigned int characterSize = text.getCharacterSize();
+	bool isBold = text.getStyle() & sf::Text::Bold;
+	float italicShear = (text.getStyle() & sf::Text::Italic) ? 0.209f : 0.f;
+
+	// same layout as sf::Text
+	float whitespaceWidth = font->getGlyph(L' ', characterSize, isBold).advance;
+	float letterSpacing = (whitespaceWidth / 3.f) * (text.getLetterSpacing() - 1.f);
+	whitespaceWidth += letterSpacing;
+	float lineSpacing = font->getLineSpacing(characterSize) * text.getLineSpacing();
+	float x = 0.f;
+	float y = static_cast<float>(characterSize);
+
+	prepare(&font->getTexture(characterSize), true, states);
+
+	const sf::String& string = text.getString();
+	const sf::Color& color = text.getFillColor();
+	sf::Uint32 prevChar = 0;
+	for (std::size_t i = 0; i < string.getSize(); i++) {
+		sf::Uint32 curChar = string[i];
+
+		if (curChar == L'\r')continue;
+
+		x += font->getKerning(prevChar, curChar, characterSize);
+		prevChar = curChar;
+
+		// whitespaces only advance the position
+		if (curChar == L' ') { x += whitespaceWidth; continue; }
+		if (curChar == L'\t') { x += whitespaceWidth * 4; continue; }
+		if (curChar == L'\n') { y += lineSpacing; x = 0; continue; }
+
+		const sf::Glyph& glyph = font->getGlyph(curChar, characterSize, isBold);
+
+		float padding = 1.f;
+		float left = glyph.bounds.left - padding;
+		float top = glyph.bounds.top - padding;
+		float right = glyph.bounds.left + glyph.bounds.width + padding;
+		float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+
+		float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+		float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+		float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
+		float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding;
+
+		sf::Vertex topLeft({ x + left - italicShear * top, y + top }, color, { u1, v1 });
+		sf::Vertex topRight({ x + right - italicShear * top, y + top }, color, { u2, v1 });
+		sf::Vertex bottomLeft({ x + left - italicShear * bottom, y + bottom }, color, { u1, v2 });
+		sf::Vertex bottomRight({ x + right - italicShear * bottom, y + bottom }, color, { u2, v2 });
+
+		appendTriangle(transform, topLeft, topRight, bottomLeft);
+		appendTriangle(transform, bottomLeft, topRight, bottomRight);
+
+		x += glyph.advance + letterSpacing;
+	}
+}
+
+void RenderBatch::add(const sf::Sprite& sprite, const sf::RenderStates& states)
+{
+	const sf::Texture* texture = sprite.getTexture();
+	if (texture == nullptr)return;
+
+	if (states.shader != nullptr) {
+		draw(sprite, states);
+		return;
+	}
+
+	sf::Transform transform = states.transform * sprite.getTransform();
+
+	sf::FloatRect bounds = sprite.getLocalBounds();
+	sf::IntRect rect = sprite.getTextureRect();
+	float left = static_cast<float>(rect.left);
+	float right = left + rect.width;
+	float top = static_cast<float>(rect.top);
+	float bottom = top + rect.height;
+
+	prepare(texture, false, states);
+
+	sf::Vertex topLeft({ 0, 0 }, sprite.getColor(), { left, top });
+	sf::Vertex topRight({ bounds.width, 0 }, sprite.getColor(), { right, top });
+	sf::Vertex bottomLeft({ 0, bounds.height }, sprite.getColor(), { left, bottom });
+	sf::Vertex bottomRight({ bounds.width, bounds.height }, sprite.getColor(), { right, bottom });
+
+	appendTriangle(transform, topLeft, topRight, bottomLeft);
+	appendTriangle(transform, bottomLeft, topRight, bottomRight);
+}
+
+void RenderBatch::add(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type, const sf::RenderStates& states)
+{
+	// only primitives made of triangles are collected
+	if (states.shader != nullptr || type == sf::Points || type == sf::Lines || type == sf::LineStrip) {
+		flush();
+		getTarget().draw(vertices, vertexCount, type, states);
+		countDraw(states.texture, vertexCount, m_contributors.size());
+		return;
+	}
+
+	sf::Vector2f texCoords = prepare(states.texture, false, states);
+	std::size_t first = m_vertices.size();
+
+	if (type == sf::Triangles) {
+		for (std::size_t i = 2; i < vertexCount; i += 3)
+			appendTriangle(states.transform, vertices[i - 2], vertices[i - 1], vertices[i]);
+	}
+	else if (type == sf::TriangleStrip) {
+		for (std::size_t i = 2; i < vertexCount; i++)
+			appendTriangle(states.transform, vertices[i - 2], vertices[i - 1], vertices[i]);
+	}
+	else if (type == sf::TriangleFan) {
+		for (std::size_t i = 2; i < vertexCount; i++)
+			appendTriangle(states.transform, vertices[0], vertices[i - 1], vertices[i]);
+	}
+	else if (type == sf::Quads) {
+		for (std::size_t i = 3; i < vertexCount; i += 4) {
+			appendTriangle(states.transform, vertices[i - 3], vertices[i - 2], vertices[i - 1]);
+			appendTriangle(states.transform, vertices[i - 3], vertices[i - 1], vertices[i]);
+		}
+	}
+
+	// texture coordinates of untextured vertices are meaningless
+	if (states.texture == nullptr) {
+		for (std::size_t i = first; i < m_vertices.size(); i++)
+			m_vertices[i].texCoords = texCoords;
+	}
+}
+
+void RenderBatch::draw(const sf::Drawable& drawable, const sf::RenderStates& states)
+{
+	flush();
+	getTarget().draw(drawable, states);
+
+	// vertices of drawables are unknown
+	countDraw(states.texture, 0, m_contributors.size());
+}
+
+void RenderBatch::flush()
+{
+	if (m_vertices.empty())return;
+
+	getTarget().draw(&m_vertices[0], m_vertices.size(), sf::Triangles, sf::RenderStates(m_blendMode, sf::Transform::Identity, m_texture, nullptr));
+	countDraw(m_texture, m_vertices.size(), 0);
+
+	m_vertices.clear();
+	m_contributors.clear();
+}
+
+unsigned int RenderBatch::getDrawCallCount() const
+{
+	return m_stats.drawCalls;
+}
+
+void RenderBatch::beginEntity(unsigned long long id)
+{
+	m_entities.push_back(id);
+}
+
+void RenderBatch::endEntity()
+{
+	m_entities.pop_back();
+}
+
+void RenderBatch::countSurface()
+{
+	m_stats.surfacesCreated++;
+	if (!m_entities.empty())m_entityStats[m_entities.back()].stats.surfacesCreated++;
+}
+
+const RenderBatch::Stats& RenderBatch::getStats() const
+{
+	return m_stats;
+}
+
+RenderBatch::Stats RenderBatch::getStats(unsigned long long id) const
+{
+	auto it = m_entityStats.find(id);
+	if (it == m_entityStats.end())return Stats();
+	return it->second.stats;
+}
+
+void RenderBatch::resetStats()
+{
+	m_stats = Stats();
+	m_entityStats.clear();
+}
+
+sf::Vector2f RenderBatch::prepare(const sf::Texture* texture, bool hasWhiteTexel, const sf::RenderStates& states)
+{
+	/*
+		geometry is compatible with the pending stream if blend modes match and :
+			untextured geometry -> stream is untextured or has a white texel
+			same texture -> always
+			other texture -> stream is untextured and the texture has a white texel,
+							 the stream then adopts the texture
+	*/
+	if (!m_vertices.empty()) {
+		bool compatible = states.blendMode == m_blendMode;
+
+		if (texture == nullptr)
+			compatible = compatible && (m_texture == nullptr || m_hasWhiteTexel);
+		else if (texture != m_texture)
+			compatible = compatible && m_untextured && hasWhiteTexel;
+
+		if (!compatible)flush();
+	}
+
+	if (m_vertices.empty()) {
+		m_texture = texture;
+		m_hasWhiteTexel = hasWhiteTexel;
+		m_blendMode = states.blendMode;
+		m_untextured = true;
+	}
+	else if (texture != nullptr && texture != m_texture) {
+		// untextured stream adopts the texture
+		for (auto it = m_vertices.begin(); it != m_vertices.end(); it++)
+			it->texCoords = whiteTexel;
+
+		m_texture = texture;
+		m_hasWhiteTexel = hasWhiteTexel;
+	}
+
+	if (texture != nullptr)m_untextured = false;
+
+	// following triangles belong to the current entity
+	if (!m_entities.empty() && (m_contributors.empty() || m_contributors.back().id != m_entities.back()))
+		m_contributors.push_back({ m_entities.back(), m_vertices.size() });
+
+	return m_hasWhiteTexel ? whiteTexel : sf::Vector2f(0, 0);
+}
+
+void RenderBatch::appendTriangle(const sf::Transform& transform, const sf::Vertex& a, const sf::Vertex& b, const sf::Vertex& c)
+{
+	m_vertices.push_back(sf::Vertex(transform.transformPoint(a.position), a.color, a.texCoords));
+	m_vertices.push_back(sf::Vertex(transform.transformPoint(b.position), b.color, b.texCoords));
+	m_vertices.push_back(sf::Vertex(transform.transformPoint(c.position), c.color, c.texCoords));
+}
+
+void RenderBatch::countDraw(const sf::Texture* texture, std::size_t vertexCount, std::size_t first)
+{
+	m_stats.drawCalls++;
+	m_stats.vertices += (unsigned int)vertexCount;
+
+	bool textureSwitch = m_stats.drawCalls > 1 && texture != m_lastDrawTexture;
+	if (textureSwitch)m_stats.textureSwitches++;
+	m_lastDrawTexture = texture;
+
+	// direct draws belong to the current entity
+	if (first == m_contributors.size()) {
+		if (m_entities.empty())return;
+
+		EntityStats& entity = m_entityStats[m_entities.back()];
+		entity.stats.drawCalls++;
+		entity.stats.vertices += (unsigned int)vertexCount;
+		if (textureSwitch)entity.stats.textureSwitches++;
+		entity.lastDrawCall = m_stats.drawCalls;
+		return;
+	}
+
+	// streams count once for every entity with triangles in them
+	for (std::size_t i = first; i < m_contributors.size(); i++) {
+		std::size_t end = i + 1 < m_contributors.size() ? m_contributors[i + 1].first : vertexCount;
+		if (end == m_contributors[i].first)continue;
+
+		EntityStats& entity = m_entityStats[m_contributors[i].id];
+		entity.stats.vertices += (unsigned int)(end - m_contributors[i].first);
+		if (entity.lastDrawCall != m_stats.drawCalls) {
+			entity.stats.drawCalls++;
+			if (textureSwitch)entity.stats.textureSwitches++;
+			entity.lastDrawCall = m_stats.drawCalls;
+		}
+	}
+}
+
+RenderBatch::EntityScope::EntityScope(RenderBatch& batch, unsigned long long id) : m_batch(batch)
+{
+	m_batch.beginEntity(id);
+}
+
+RenderBatch::EntityScope::~EntityScope()
+{
+	m_batch.endEntity();
+}
@@ -0,0 +1,324 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace gui {
+
+////////////////////////////////////////////////////////////
+/// \brief Collects the geometry of shapes, texts, sprites and vertices
+///		   into one stream of triangles and draws it with a single draw call
+///
+/// Geometry is transformed on the cpu, so entities with different
+/// transforms share a stream. A stream is drawn (flushed) only when
+/// the texture, blend mode or target changes, which keeps the paint order.
+/// Untextured geometry joins a stream textured by a font, since every
+/// font texture reserves a white square for underlines.
+///
+////////////////////////////////////////////////////////////
+class RenderBatch {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Blend mode drawing a surface the batch rendered to
+	///		   onto another target
+	///
+	/// Geometry alpha blended onto a surface cleared with a
+	/// premultiplied color leaves its colors multiplied by their
+	/// alpha, the surface must not be multiplied a second time.
+	///
+	////////////////////////////////////////////////////////////
+	static const sf::BlendMode BlendPremultiplied;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Rendering costs counted by the batch
+	///
+	////////////////////////////////////////////////////////////
+	struct Stats {
+		unsigned int drawCalls;			/// < draw calls issued
+		unsigned int vertices;			/// < vertices drawn
+		unsigned int textureSwitches;	/// < draw calls using another texture than the previous one
+		unsigned int surfacesCreated;	/// < offscreen surfaces created
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Fill and outline of a convex shape as triangles in the local
+	///		   coordinates of its points, built once and added any number of times
+	///
+	////////////////////////////////////////////////////////////
+	struct Mesh {
+
+		////////////////////////////////////////////////////////////
+		/// \brief Tessellate a shape with the given colors and outline,
+		///		   its own colors and outline are ignored
+		///
+		////////////////////////////////////////////////////////////
+		void build(const sf::Shape& shape, const sf::Color& fillColor, const sf::Color& outlineColor, float outlineThickness);
+
+		std::vector<sf::Vertex> fill;		/// < triangle fan around the center of the points
+		std::vector<sf::Vertex> outline;	/// < triangle strip around the points, empty without outline
+		const sf::Texture* texture = nullptr;	/// < texture of the fill
+		sf::FloatRect bounds;				/// < rectangle covered by the fill and the outline
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Attributes costs to an entity from construction to destruction
+	///
+	////////////////////////////////////////////////////////////
+	class EntityScope {
+	public:
+		EntityScope(RenderBatch& batch, unsigned long long id);
+		~EntityScope();
+
+	private:
+		RenderBatch& m_batch;	/// < batch counting the costs
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor, batch has no target
+	///
+	////////////////////////////////////////////////////////////
+	RenderBatch();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Construct the batch drawing on target
+	///
+	/// \param target -> Render target to draw to
+	///
+	////////////////////////////////////////////////////////////
+	RenderBatch(sf::RenderTarget& target);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the pending geometry and make target the current target
+	///		   until popTarget is called
+	///
+	/// \param target -> Render target to draw to
+	///
+	////////////////////////////////////////////////////////////
+	void pushTarget(sf::RenderTarget& target);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the pending geometry and restore the previous target
+	///
+	////////////////////////////////////////////////////////////
+	void popTarget();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the current target
+	///
+	/// \return Render target the geometry is drawn to
+	///
+	////////////////////////////////////////////////////////////
+	sf::RenderTarget& getTarget() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the fill and outline of a shape
+	///
+	/// \param shape -> Shape to add
+	/// \param states -> Render states to apply
+	///
+	////////////////////////////////////////////////////////////
+	void add(const sf::Shape& shape, const sf::RenderStates& states = sf::RenderStates::Default);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the fill and outline of a built mesh
+	///
+	/// \param mesh -> Mesh to add
+	/// \param states -> Render states to apply, the texture of the mesh replaces their texture
+	///
+	////////////////////////////////////////////////////////////
+	void add(const Mesh& mesh, const sf::RenderStates& states = sf::RenderStates::Default);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the fill and outline of a built mesh, its fill
+	///		   shown with another color
+	///
+	/// The mesh is unchanged, its fill is recolored on a reused copy.
+	///
+	/// \param mesh -> Mesh to add
+	/// \param fillColor -> Color of every vertex of the fill
+	/// \param states -> Render states to apply, the texture of the mesh replaces their texture
+	///
+	////////////////////////////////////////////////////////////
+	void add(const Mesh& mesh, const sf::Color& fillColor, const sf::RenderStates& states = sf::RenderStates::Default);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the glyphs of a text
+	///		   Underlined, struck through and outlined texts are drawn directly
+	///
+	/// \param text -> Text to add
+	/// \param states -> Render states to apply
+	///
+	////////////////////////////////////////////////////////////
+	void add(const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a sprite
+	///
+	/// \param sprite -> Sprite to add
+	/// \param states -> Render states to apply
+	///
+	////////////////////////////////////////////////////////////
+	void add(const sf::Sprite& sprite, const sf::RenderStates& states = sf::RenderStates::Default);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add primitives defined by an array of vertices
+	///		   Points and lines are drawn directly
+	///
+	/// \param vertices -> Pointer to the vertices
+	/// \param vertexCount -> Number of vertices in the array
+	/// \param type -> Type of primitives to draw
+	/// \param states -> Render states to apply
+	///
+	////////////////////////////////////////////////////////////
+	void add(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type, const sf::RenderStates& states = sf::RenderStates::Default);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the pending geometry and then the drawable directly
+	///		   Used for anything the batch cannot collect
+	///
+	/// \param drawable -> Object to draw
+	/// \param states -> Render states to apply
+	///
+	////////////////////////////////////////////////////////////
+	void draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Draw the pending geometry on the current target
+	///
+	/// Has to be called before the view of the target is changed
+	/// and before the target is displayed
+	///
+	////////////////////////////////////////////////////////////
+	void flush();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of draw calls issued since the last reset
+	///
+	/// \return number of draw calls
+	///
+	////////////////////////////////////////////////////////////
+	unsigned int getDrawCallCount() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Start attributing costs to an entity, until endEntity
+	///
+	/// Entities nest, costs go to the innermost one only. A draw call
+	/// of a stream shared by several entities counts for each of them.
+	///
+	/// \param id -> gui Id of the entity
+	///
+	////////////////////////////////////////////////////////////
+	void beginEntity(unsigned long long id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Stop attributing costs to the innermost entity
+	///
+	////////////////////////////////////////////////////////////
+	void endEntity();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Count an offscreen surface created for the current entity
+	///
+	////////////////////////////////////////////////////////////
+	void countSurface();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the costs counted since the last reset
+	///
+	////////////////////////////////////////////////////////////
+	const Stats& getStats() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the costs attributed to an entity since the last reset
+	///
+	/// \param id -> gui Id of the entity
+	///
+	/// \return Costs of the entity, zero if it cost nothing
+	///
+	////////////////////////////////////////////////////////////
+	Stats getStats(unsigned long long id) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set every count to zero
+	///
+	////////////////////////////////////////////////////////////
+	void resetStats();
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Prepare the stream for geometry with texture and states,
+	///		   flush the stream if they are incompatible
+	///
+	/// \param texture -> Texture of the geometry, nullptr if untextured
+	/// \param hasWhiteTexel -> whether texture reserves a white square (font textures)
+	/// \param states -> Render states of the geometry
+	///
+	/// \return Texture coordinates to use for untextured geometry
+	///
+	////////////////////////////////////////////////////////////
+	sf::Vector2f prepare(const sf::Texture* texture, bool hasWhiteTexel, const sf::RenderStates& states);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add a fill and the outline of a built mesh
+	///
+	/// \param fill -> Vertices of the fill, those of the mesh or a recolored copy
+	///
+	////////////////////////////////////////////////////////////
+	void addMesh(const Mesh& mesh, const std::vector<sf::Vertex>& fill, const sf::RenderStates& states);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Append a triangle transformed by transform
+	///
+	////////////////////////////////////////////////////////////
+	void appendTriangle(const sf::Transform& transform, const sf::Vertex& a, const sf::Vertex& b, const sf::Vertex& c);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Count a draw call of vertexCount vertices with texture
+	///
+	/// \param first -> First contributor of m_contributors drawn by the call
+	///
+	////////////////////////////////////////////////////////////
+	void countDraw(const sf::Texture* texture, std::size_t vertexCount, std::size_t first);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Part of the pending stream added by an entity
+	///
+	////////////////////////////////////////////////////////////
+	struct Contributor {
+		unsigned long long id;	/// < gui Id of the entity
+		std::size_t first;		/// < index of its first vertex in m_vertices
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Costs of an entity
+	///
+	////////////////////////////////////////////////////////////
+	struct EntityStats {
+		Stats stats;					/// < costs attributed to the entity
+		unsigned int lastDrawCall;		/// < draw call which last counted for the entity
+	};
+
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+
+	std::vector<sf::RenderTarget*> m_targets;						/// < stack of targets, last one is current
+	std::vector<sf::Vertex> m_vertices;								/// < pending triangles in target coordinates
+	const sf::Texture* m_texture;									/// < texture of the pending triangles
+	sf::BlendMode m_blendMode;										/// < blend mode of the pending triangles
+	bool m_hasWhiteTexel;											/// < whether untextured geometry can use m_texture
+	bool m_untextured;												/// < whether every pending triangle is untextured
+	Mesh m_mesh;													/// < reused storage for tessellated shapes
+	std::vector<sf::Vertex> m_recolored;							/// < reused storage for fills added with another color
+	Stats m_stats;													/// < costs since the last reset
+	std::vector<unsigned long long> m_entities;						/// < stack of entities being drawn, last one is current
+	std::vector<Contributor> m_contributors;						/// < entities of the pending triangles, in order
+	std::unordered_map<unsigned long long, EntityStats> m_entityStats;	/// < costs per gui Id since the last reset
+	const sf::Texture* m_lastDrawTexture;							/// < texture of the last draw call
+};
+
+} // namespace gui
@@ -120,11 +120,16 @@ Entity* Page::Scroll::isHit(const sf::Vector2f& point)
 	return m_bar.contains(point) ? &m_bar : m_rect.isHit(point);
 }
 
-void Page::Scroll::draw(sf::RenderTarget& target, sf::RenderStates states) const
+sf::FloatRect Page::Scroll::getDrawBounds() const
+{
+	return uniteRects(m_rect.getDrawBounds(), m_bar.getDrawBounds());
+}
+
+void Page::Scroll::submit(RenderBatch& batch, sf::RenderStates states) const
 {
 	if (isActive()) {
-		m_rect.draw(target, states);
-		m_bar.draw(target, states);
+		m_rect.submit(batch, states);
+		m_bar.submit(batch, states);
 	}
 }
 
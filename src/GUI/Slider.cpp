@@ -32,15 +32,20 @@ void Slider::setVariable(float& var, float lower_limit, float upper_limit)
 
 		// map offset to variable
 		*m_variable = m_limits[0] + (m_offset / (m_box.getSize().x - m_bar.getLocalBounds().width)) * (m_limits[1] - m_limits[0]);
+
+		invalidate();
 	};
+	invalidate();
 }
 void Slider::setBarFillColor(sf::Color color)
 {
 	m_bar.setFillColor(color);
+	invalidate();
 }
 void Slider::setBarSelectionColor(sf::Color color)
 {
 	m_bar.setSelectionFillColor(color);
+	invalidate();
 }
 void Slider::setSize(const sf::Vector2f& size)
 {
@@ -52,11 +57,13 @@ void Slider::setSize(const sf::Vector2f& size)
 	m_bar.setPoint(1, sf::Vector2f(barSize.x, 0));
 	m_bar.setPoint(2, sf::Vector2f(barSize.x, barSize.y));
 	m_bar.setPoint(3, sf::Vector2f(0, barSize.y));
+	invalidate();
 }
 void Slider::reset()
 {
 	m_offset = 0;
 	if (m_variable != nullptr) *m_variable = m_limits[0];
+	invalidate();
 }
 Entity* Slider::isHit(const sf::Vector2f& point)
 {
@@ -71,13 +78,15 @@ void Slider::activateSelection()
 {
 	m_selected = true;
 	m_bar.activateSelection();
+	invalidate();
 }
 void Slider::deactivateSelection()
 {
 	m_selected = false;
 	m_bar.deactivateSelection();
+	invalidate();
 }
-void Slider::draw(sf::RenderTarget& target, sf::RenderStates states) const
+void Slider::submit(RenderBatch& batch, sf::RenderStates states) const
 {
 	if (isActive()) {
 		// save transform
@@ -94,16 +103,16 @@ void Slider::draw(sf::RenderTarget& target, sf::RenderStates states) const
 			{states.transform.transformPoint(m_box.getSize().x * 0.6f, m_box.getSize().y * 0.5 + halfWidth), sf::Color::Yellow },
 			{states.transform.transformPoint(0, m_box.getSize().y * 0.5 + halfWidth), sf::Color::Green}
 		};
-		target.draw(midLine, 4, sf::Quads);
+		batch.add(midLine, 4, sf::Quads);
 
 		midLine[0] = { states.transform.transformPoint(m_box.getSize().x * 0.3f, m_box.getSize().y * 0.5 - halfWidth), sf::Color::Yellow };
 		midLine[1] = { states.transform.transformPoint(m_box.getSize().x, m_box.getSize().y * 0.5 - halfWidth), sf::Color::Red };
 		midLine[2] = { states.transform.transformPoint(m_box.getSize().x, m_box.getSize().y * 0.5 + halfWidth), sf::Color::Red };
 		midLine[3] = { states.transform.transformPoint(m_box.getSize().x * 0.3f, m_box.getSize().y * 0.5 + halfWidth), sf::Color::Yellow };
-		target.draw(midLine, 4, sf::Quads);
+		batch.add(midLine, 4, sf::Quads);
 
 		// draw box
-		target.draw(m_box, states);
+		batch.add(m_box, states);
 
 		// apply transform to text
 		// since translation is last operation, text is translated w.r.t box
@@ -112,7 +121,7 @@ void Slider::draw(sf::RenderTarget& target, sf::RenderStates states) const
 			m_box.getSize().y * 0.5f - m_text.getGlobalBounds().height
 		);
 		//draw text
-		target.draw(m_text, states);
+		batch.add(m_text, states);
 
 		// reuse transform
 		states.transform = transform * getTransform();
@@ -121,6 +130,6 @@ void Slider::draw(sf::RenderTarget& target, sf::RenderStates states) const
 		states.transform.translate(m_offset, getSize().y * 0.25 * 0.5);
 
 		//draw bar
-		m_bar.draw(target, states);
+		m_bar.submit(batch, states);
 	}
 }
\ No newline at end of file
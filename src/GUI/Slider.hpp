@@ -81,13 +81,13 @@ public:
 	virtual void deactivateSelection() override;
 
 	////////////////////////////////////////////////////////////
-	/// \brief Draws the object to the target applying its states
+	/// \brief Add the geometry of the object to the batch applying its states
 	/// 
-	/// \param target -> Render target to draw to
+	/// \param batch -> Batch collecting the geometry
 	/// \param states -> Current render states
 	/// 
 	////////////////////////////////////////////////////////////
-	virtual void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const override;
+	virtual void submit(RenderBatch& batch, sf::RenderStates states = sf::RenderStates::Default) const override;
 
 	///////////////////////////////////////////////////////////
 	/// action is defined automatically, users are not allowed to alter it
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace gui {
+
+////////////////////////////////////////////////////////////
+/// \brief Reference to a value of a SlotMap
+///
+/// A handle stays valid until its value is removed, after which
+/// the slot may be reused by another value with a new generation.
+/// The default handle never refers to anything.
+///
+////////////////////////////////////////////////////////////
+struct Handle {
+	unsigned int index = 0;			/// < slot of the value
+	unsigned int generation = 0;	/// < generation of the slot when the value was inserted, never 0 for a valid handle
+
+	bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Array of values addressed by generational handles
+///
+/// Lookup is an array index and a generation compare. Removed
+/// slots are reused oldest first, so an index comes back as late
+/// as possible, while the generation tells old handles apart.
+///
+////////////////////////////////////////////////////////////
+template <typename T>
+class SlotMap {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor, map is empty
+	///
+	////////////////////////////////////////////////////////////
+	SlotMap() : m_freeHead(none), m_freeTail(none), m_size(0), m_removals(0) {}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Insert a value
+	///
+	/// \return Handle of the value
+	///
+	////////////////////////////////////////////////////////////
+	Handle insert(const T& value)
+	{
+		unsigned int index;
+		if (m_freeHead != none) {
+			index = m_freeHead;
+			m_freeHead = m_slots[index].nextFree;
+			if (m_freeHead == none)m_freeTail = none;
+		}
+		else {
+			index = (unsigned int)m_slots.size();
+			m_slots.push_back(Slot());
+		}
+
+		Slot& slot = m_slots[index];
+		slot.value = value;
+		slot.occupied = true;
+		m_size++;
+
+		Handle handle;
+		handle.index = index;
+		handle.generation = slot.generation;
+		return handle;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove the value of a handle
+	///
+	/// \return false if the handle was already invalid
+	///
+	////////////////////////////////////////////////////////////
+	bool remove(const Handle& handle)
+	{
+		if (!contains(handle))return false;
+
+		Slot& slot = m_slots[handle.index];
+		slot.value = T();
+		slot.occupied = false;
+
+		// generation 0 is reserved for the default handle
+		if (++slot.generation == 0)slot.generation = 1;
+
+		// freed slots are reused last
+		slot.nextFree = none;
+		if (m_freeTail != none)m_slots[m_freeTail].nextFree = handle.index;
+		else m_freeHead = handle.index;
+		m_freeTail = handle.index;
+
+		m_size--;
+		m_removals++;
+		return true;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if a handle refers to a value
+	///
+	////////////////////////////////////////////////////////////
+	bool contains(const Handle& handle) const
+	{
+		return handle.index < m_slots.size() && m_slots[handle.index].occupied && m_slots[handle.index].generation == handle.generation;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the value of a handle
+	///
+	/// \return Pointer to the value, nullptr if the handle is invalid
+	///
+	////////////////////////////////////////////////////////////
+	T* get(const Handle& handle)
+	{
+		return contains(handle) ? &m_slots[handle.index].value : nullptr;
+	}
+
+	const T* get(const Handle& handle) const
+	{
+		return contains(handle) ? &m_slots[handle.index].value : nullptr;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the handle of the value currently in a slot
+	///
+	/// \return Handle of the value, default handle if the slot is empty
+	///
+	////////////////////////////////////////////////////////////
+	Handle getHandle(unsigned int index) const
+	{
+		Handle handle;
+		if (index < m_slots.size() && m_slots[index].occupied) {
+			handle.index = index;
+			handle.generation = m_slots[index].generation;
+		}
+		return handle;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of values
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getSize() const
+	{
+		return m_size;
+	}
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of removals since construction,
+	///		   changes whenever some handle becomes invalid
+	///
+	////////////////////////////////////////////////////////////
+	unsigned long long getRemovalCount() const
+	{
+		return m_removals;
+	}
+
+private:
+	static const unsigned int none = ~0u;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Storage of one value
+	///
+	////////////////////////////////////////////////////////////
+	struct Slot {
+		T value = T();					/// < stored value, default constructed if empty
+		unsigned int generation = 1;	/// < incremented every time the value is removed
+		unsigned int nextFree = none;	/// < next slot of the free list
+		bool occupied = false;			/// < whether the slot holds a value
+	};
+
+	std::vector<Slot> m_slots;		/// < every slot ever used
+	unsigned int m_freeHead;		/// < oldest free slot, none if no slot is free
+	unsigned int m_freeTail;		/// < newest free slot, none if no slot is free
+	std::size_t m_size;				/// < number of occupied slots
+	unsigned long long m_removals;	/// < number of removed values
+};
+
+} // namespace gui
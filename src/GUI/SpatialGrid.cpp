@@ -0,0 +1,211 @@
+#include "SpatialGrid.hpp"
+#include "GUIFrame.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace gui;
+
+// entities covering more cells are not stored in cells
+static const int maxCellsPerEntity = 64;
+
+SpatialGrid::SpatialGrid(float cellSize)
+{
+	m_cellSize = cellSize;
+	m_stamp = 0;
+}
+
+void SpatialGrid::insert(Entity& entity, unsigned int order)
+{
+	if (m_entries.find(entity.getID()) != m_entries.end()) {
+		setOrder(entity.getID(), order);
+		invalidate(entity.getID());
+		return;
+	}
+
+	Entry entry;
+	entry.entity = &entity;
+	entry.cells = sf::IntRect();
+	entry.order = order;
+	entry.stamp = 0;
+	entry.oversized = false;
+	entry.stale = true;
+
+	m_entries[entity.getID()] = entry;
+	m_stale.push_back(entity.getID());
+}
+
+void SpatialGrid::remove(unsigned long long id)
+{
+	auto entry = m_entries.find(id);
+	if (entry == m_entries.end())return;
+
+	unlink(id, entry->second);
+	m_entries.erase(entry);
+
+	// stale list may still hold the id, refresh skips missing ids
+}
+
+void SpatialGrid::clear()
+{
+	m_entries.clear();
+	m_cells.clear();
+	m_oversized.clear();
+	m_stale.clear();
+}
+
+void SpatialGrid::setOrder(unsigned long long id, unsigned int order)
+{
+	auto entry = m_entries.find(id);
+	if (entry != m_entries.end())entry->second.order = order;
+}
+
+void SpatialGrid::invalidate(unsigned long long id)
+{
+	auto entry = m_entries.find(id);
+	if (entry == m_entries.end() || entry->second.stale)return;
+
+	entry->second.stale = true;
+	m_stale.push_back(id);
+}
+
+void SpatialGrid::refresh()
+{
+	for (auto id = m_stale.begin(); id != m_stale.end(); id++) {
+		auto it = m_entries.find(*id);
+		if (it == m_entries.end() || !it->second.stale)continue;
+
+		Entry& entry = it->second;
+		entry.stale = false;
+		entry.bounds = entry.entity->getCachedDrawBounds();
+
+		// entity stays inside the same cells
+		sf::IntRect cells = getCells(entry.bounds);
+		if (cells == entry.cells)continue;
+
+		unlink(*id, entry);
+		entry.cells = cells;
+		link(*id, entry);
+	}
+	m_stale.clear();
+}
+
+void SpatialGrid::query(const sf::Vector2f& point, std::vector<Entity*>& result)
+{
+	refresh();
+	m_stamp++;
+	m_collected.clear();
+
+	auto test = [&point](const Entry& entry) { return entry.bounds.contains(point); };
+
+	auto cell = m_cells.find(getKey((int)std::floor(point.x / m_cellSize), (int)std::floor(point.y / m_cellSize)));
+	if (cell != m_cells.end())collect(cell->second, test);
+	collect(m_oversized, test);
+
+	sortCollected(result);
+}
+
+void SpatialGrid::query(const sf::FloatRect& rect, std::vector<Entity*>& result)
+{
+	refresh();
+	m_stamp++;
+	m_collected.clear();
+
+	auto test = [&rect](const Entry& entry) { return entry.bounds.intersects(rect); };
+
+	sf::IntRect cells = getCells(rect);
+	for (int x = cells.left; x < cells.left + cells.width; x++) {
+		for (int y = cells.top; y < cells.top + cells.height; y++) {
+			auto cell = m_cells.find(getKey(x, y));
+			if (cell != m_cells.end())collect(cell->second, test);
+		}
+	}
+	collect(m_oversized, test);
+
+	sortCollected(result);
+}
+
+std::size_t SpatialGrid::getSize() const
+{
+	return m_entries.size();
+}
+
+unsigned long long SpatialGrid::getKey(int x, int y)
+{
+	return ((unsigned long long)(unsigned int)x << 32) | (unsigned int)y;
+}
+
+sf::IntRect SpatialGrid::getCells(const sf::FloatRect& rect) const
+{
+	// rectangles without area are not in any cell
+	if (rect.width <= 0 || rect.height <= 0)return sf::IntRect();
+
+	int left = (int)std::floor(rect.left / m_cellSize);
+	int top = (int)std::floor(rect.top / m_cellSize);
+	int right = (int)std::floor((rect.left + rect.width) / m_cellSize);
+	int bottom = (int)std::floor((rect.top + rect.height) / m_cellSize);
+
+	return sf::IntRect(left, top, right - left + 1, bottom - top + 1);
+}
+
+void SpatialGrid::link(unsigned long long id, Entry& entry)
+{
+	if (entry.cells.width <= 0 || entry.cells.height <= 0)return;
+
+	if (entry.cells.width * entry.cells.height > maxCellsPerEntity) {
+		entry.oversized = true;
+		m_oversized.push_back(id);
+		return;
+	}
+
+	for (int x = entry.cells.left; x < entry.cells.left + entry.cells.width; x++) {
+		for (int y = entry.cells.top; y < entry.cells.top + entry.cells.height; y++)
+			m_cells[getKey(x, y)].push_back(id);
+	}
+}
+
+void SpatialGrid::unlink(unsigned long long id, Entry& entry)
+{
+	if (entry.oversized) {
+		m_oversized.erase(std::find(m_oversized.begin(), m_oversized.end(), id));
+		entry.oversized = false;
+		return;
+	}
+
+	for (int x = entry.cells.left; x < entry.cells.left + entry.cells.width; x++) {
+		for (int y = entry.cells.top; y < entry.cells.top + entry.cells.height; y++) {
+			auto cell = m_cells.find(getKey(x, y));
+			if (cell == m_cells.end())continue;
+
+			// order inside a cell does not matter, swap with last
+			std::vector<unsigned long long>& ids = cell->second;
+			auto it = std::find(ids.begin(), ids.end(), id);
+			if (it != ids.end()) {
+				*it = ids.back();
+				ids.pop_back();
+			}
+			if (ids.empty())m_cells.erase(cell);
+		}
+	}
+}
+
+template <typename Test>
+void SpatialGrid::collect(const std::vector<unsigned long long>& ids, const Test& test)
+{
+	for (auto id = ids.begin(); id != ids.end(); id++) {
+		Entry& entry = m_entries.at(*id);
+		if (entry.stamp == m_stamp)continue;
+
+		entry.stamp = m_stamp;
+		if (test(entry))m_collected.push_back(&entry);
+	}
+}
+
+void SpatialGrid::sortCollected(std::vector<Entity*>& result)
+{
+	std::sort(m_collected.begin(), m_collected.end(), [](const Entry* a, const Entry* b) { return a->order < b->order; });
+
+	result.clear();
+	for (auto it = m_collected.begin(); it != m_collected.end(); it++)
+		result.push_back((*it)->entity);
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace gui {
+
+class Entity;
+
+////////////////////////////////////////////////////////////
+/// \brief Uniform grid of cells holding the entities whose draw bounds overlap them
+///
+/// Entities are marked stale when they change and are moved to their
+/// new cells on the next refresh, an entity which stays inside the same
+/// cells costs nothing. Queries only visit the cells under the point or
+/// rectangle. Entities covering too many cells are kept in a separate
+/// list which every query visits.
+///
+////////////////////////////////////////////////////////////
+class SpatialGrid {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param cellSize -> Width and height of one cell
+	///
+	////////////////////////////////////////////////////////////
+	SpatialGrid(float cellSize = 128.f);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Insert an entity, its bounds are computed on the next refresh
+	///
+	/// \param entity -> Entity to insert
+	/// \param order -> Stacking order, entities with greater order are above
+	///
+	////////////////////////////////////////////////////////////
+	void insert(Entity& entity, unsigned int order);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove an entity by its unique Id
+	///
+	////////////////////////////////////////////////////////////
+	void remove(unsigned long long id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove every entity
+	///
+	////////////////////////////////////////////////////////////
+	void clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change the stacking order of an entity
+	///
+	/// \param id -> Unique Id of the entity
+	/// \param order -> New stacking order
+	///
+	////////////////////////////////////////////////////////////
+	void setOrder(unsigned long long id, unsigned int order);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark the bounds of an entity as changed
+	///		   Ids which are not in the grid are ignored
+	///
+	////////////////////////////////////////////////////////////
+	void invalidate(unsigned long long id);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Move stale entities to the cells of their current draw bounds
+	///
+	////////////////////////////////////////////////////////////
+	void refresh();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the entities whose draw bounds contain the point
+	///
+	/// \param point -> Point in the coordinate system of the draw bounds
+	/// \param result -> Entities sorted back to front, previous content is cleared
+	///
+	////////////////////////////////////////////////////////////
+	void query(const sf::Vector2f& point, std::vector<Entity*>& result);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the entities whose draw bounds intersect the rectangle
+	///
+	/// \param rect -> Rectangle in the coordinate system of the draw bounds
+	/// \param result -> Entities sorted back to front, previous content is cleared
+	///
+	////////////////////////////////////////////////////////////
+	void query(const sf::FloatRect& rect, std::vector<Entity*>& result);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of entities in the grid
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getSize() const;
+
+private:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Entity stored in the grid
+	///
+	////////////////////////////////////////////////////////////
+	struct Entry {
+		Entity* entity;			/// < stored entity
+		sf::FloatRect bounds;	/// < draw bounds at the last refresh
+		sf::IntRect cells;		/// < range of cells covered by bounds, empty if not in any cell
+		unsigned int order;		/// < stacking order
+		unsigned int stamp;		/// < last query which visited the entry, avoids duplicates
+		bool oversized;			/// < whether the entry is in the oversized list instead of cells
+		bool stale;				/// < whether the bounds have to be refreshed
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the key of a cell from its coordinates
+	///
+	////////////////////////////////////////////////////////////
+	static unsigned long long getKey(int x, int y);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the range of cells covered by a rectangle
+	///
+	////////////////////////////////////////////////////////////
+	sf::IntRect getCells(const sf::FloatRect& rect) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the id to the cells of the entry
+	///
+	////////////////////////////////////////////////////////////
+	void link(unsigned long long id, Entry& entry);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remove the id from the cells of the entry
+	///
+	////////////////////////////////////////////////////////////
+	void unlink(unsigned long long id, Entry& entry);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the entities of the ids passing the test to the result once
+	///
+	////////////////////////////////////////////////////////////
+	template <typename Test>
+	void collect(const std::vector<unsigned long long>& ids, const Test& test);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Sort the collected entities back to front into result
+	///
+	////////////////////////////////////////////////////////////
+	void sortCollected(std::vector<Entity*>& result);
+
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+
+	float m_cellSize;													/// < width and height of one cell
+	std::unordered_map<unsigned long long, Entry> m_entries;			/// < maps gui Ids to their entries
+	std::unordered_map<unsigned long long, std::vector<unsigned long long>> m_cells;	/// < maps cell keys to the ids of entities overlapping them
+	std::vector<unsigned long long> m_oversized;						/// < ids of entities covering too many cells
+	std::vector<unsigned long long> m_stale;							/// < ids of entities to refresh
+	std::vector<Entry*> m_collected;									/// < reused storage for query results
+	unsigned int m_stamp;												/// < id of the current query
+};
+
+} // namespace gui
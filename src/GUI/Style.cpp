@@ -0,0 +1,75 @@
+#include "Style.hpp"
+
+using namespace gui;
+
+// swaps of every theme, compared by frames and pages to redraw everything
+static unsigned long long themeChangeCount = 0;
+
+Style::Style()
+{
+	m_transitionEasing = Animator::Easing::SMOOTH;
+}
+Style::Style(const Look& normal, const Look& selection)
+{
+	m_transitionEasing = Animator::Easing::SMOOTH;
+	m_looks[NORMAL] = normal;
+	m_looks[HOVER] = selection;
+	m_looks[PRESSED] = selection;
+}
+Style::Style(const Look& normal, const Look& hover, const Look& pressed)
+{
+	m_transitionEasing = Animator::Easing::SMOOTH;
+	m_looks[NORMAL] = normal;
+	m_looks[HOVER] = hover;
+	m_looks[PRESSED] = pressed;
+}
+void Style::setLook(State state, const Look& look)
+{
+	m_looks[state] = look;
+}
+const Style::Look& Style::getLook(State state) const
+{
+	return m_looks[state];
+}
+void Style::setTransition(sf::Time duration, Animator::Easing easing)
+{
+	m_transitionDuration = duration;
+	m_transitionEasing = easing;
+}
+sf::Time Style::getTransitionDuration() const
+{
+	return m_transitionDuration;
+}
+Animator::Easing Style::getTransitionEasing() const
+{
+	return m_transitionEasing;
+}
+const std::shared_ptr<const Style>& Style::getDefault()
+{
+	// shared by every widget created without a style
+	static const std::shared_ptr<const Style> style = std::make_shared<const Style>();
+	return style;
+}
+Theme::Theme(const std::shared_ptr<const Style>& style)
+{
+	m_style = style;
+	m_version = 0;
+}
+void Theme::setStyle(const std::shared_ptr<const Style>& style)
+{
+	m_style = style;
+	m_version++;
+	themeChangeCount++;
+}
+const std::shared_ptr<const Style>& Theme::getStyle() const
+{
+	return m_style;
+}
+unsigned int Theme::getVersion() const
+{
+	return m_version;
+}
+unsigned long long Theme::getChangeCount()
+{
+	return themeChangeCount;
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "Animator.hpp"
+#include <memory>
+
+namespace gui {
+
+////////////////////////////////////////////////////////////
+/// \brief Appearance of a widget in each of its states
+///
+/// A style is immutable once shared : widgets hold it as a
+/// std::shared_ptr<const Style>, so any number of widgets can
+/// use the same one. A widget setter gives that widget its own
+/// modified copy and leaves the others untouched, the copy is
+/// made once and changed in place while only the widget holds it.
+/// Styles to be swapped at runtime are set through a Theme.
+/// \code
+/// gui::Style::Look normal, hover;
+/// normal.fillColor = sf::Color::Transparent;
+/// hover.fillColor = sf::Color(160, 32, 240, 126);
+/// auto style = std::make_shared<const gui::Style>(normal, hover);
+/// for (auto& button : buttons)button.setButtonStyle(style);
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class Style {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief States of a widget having a look
+	///
+	////////////////////////////////////////////////////////////
+	enum State { NORMAL, HOVER, PRESSED, STATE_COUNT };
+
+	////////////////////////////////////////////////////////////
+	/// \brief Properties of the shape of a widget in one state
+	///
+	////////////////////////////////////////////////////////////
+	struct Look {
+		sf::Color fillColor = sf::Color::White;		/// < fill color of the shape
+		sf::Color outlineColor = sf::Color::White;	/// < color of the outline of the shape
+		float outlineThickness = 0;					/// < thickness of the outline of the shape
+		sf::Vector2f scale = sf::Vector2f(1, 1);	/// < scale of the widget, the normal state keeps the scale set on the widget
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor, every state has the default look
+	///
+	////////////////////////////////////////////////////////////
+	Style();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param normal -> Look when the widget is not pointed
+	/// \param selection -> Look when the widget is hovered or pressed
+	///
+	////////////////////////////////////////////////////////////
+	Style(const Look& normal, const Look& selection);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param normal -> Look when the widget is not pointed
+	/// \param hover -> Look when the widget is hovered
+	/// \param pressed -> Look when the widget is hovered and pressed
+	///
+	////////////////////////////////////////////////////////////
+	Style(const Look& normal, const Look& hover, const Look& pressed);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the look of a state, only while the style is not shared
+	///
+	////////////////////////////////////////////////////////////
+	void setLook(State state, const Look& look);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the look of a state
+	///
+	////////////////////////////////////////////////////////////
+	const Look& getLook(State state) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Ease the scale of the widget when its state changes,
+	///		   only while the style is not shared
+	///
+	/// By default, the duration is zero and the scale is set at once.
+	/// Widgets ease only while attached to a frame, whose animator drives them.
+	///
+	/// \param duration -> Duration of the change of scale
+	/// \param easing -> Curve of the change of scale
+	///
+	////////////////////////////////////////////////////////////
+	void setTransition(sf::Time duration, Animator::Easing easing = Animator::Easing::SMOOTH);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the duration of the change of scale between states
+	///
+	////////////////////////////////////////////////////////////
+	sf::Time getTransitionDuration() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the curve of the change of scale between states
+	///
+	////////////////////////////////////////////////////////////
+	Animator::Easing getTransitionEasing() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the style used by widgets until another is set,
+	///		   every state has the default look
+	///
+	////////////////////////////////////////////////////////////
+	static const std::shared_ptr<const Style>& getDefault();
+
+	////////////////////////////////////////////////////////////
+	// Member Data
+	////////////////////////////////////////////////////////////
+
+private:
+	Look m_looks[STATE_COUNT];					/// < look of every state
+	sf::Time m_transitionDuration;				/// < duration of the change of scale between states
+	Animator::Easing m_transitionEasing;		/// < curve of the change of scale between states
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Swappable style that widgets point to
+///
+/// Widgets given a theme show whatever style the theme holds,
+/// setting another style on the theme restyles all of them at
+/// their next draw, and frames and pages redraw everything once.
+/// A look setter on a widget gives it its own copy of the style
+/// and leaves the theme.
+/// \code
+/// auto theme = std::make_shared<gui::Theme>(lightStyle);
+/// for (auto& button : buttons)button.setButtonTheme(theme);
+/// theme->setStyle(darkStyle);
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class Theme {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Constructor
+	///
+	/// \param style -> Style of the theme, must not be nullptr
+	///
+	////////////////////////////////////////////////////////////
+	Theme(const std::shared_ptr<const Style>& style = Style::getDefault());
+
+	////////////////////////////////////////////////////////////
+	/// \brief Swap the style of the theme for every widget using it
+	///
+	/// \param style -> New style, must not be nullptr
+	///
+	////////////////////////////////////////////////////////////
+	void setStyle(const std::shared_ptr<const Style>& style);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the style of the theme
+	///
+	////////////////////////////////////////////////////////////
+	const std::shared_ptr<const Style>& getStyle() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of times the style of the theme was swapped
+	///
+	////////////////////////////////////////////////////////////
+	unsigned int getVersion() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of times the style of any theme was swapped,
+	///		   frames and pages redraw everything when it changes
+	///
+	////////////////////////////////////////////////////////////
+	static unsigned long long getChangeCount();
+
+	////////////////////////////////////////////////////////////
+	// Member Data
+	////////////////////////////////////////////////////////////
+
+private:
+	std::shared_ptr<const Style> m_style;		/// < style shown by the widgets using the theme
+	unsigned int m_version;						/// < incremented by every swap of the style
+};
+
+} // namespace gui
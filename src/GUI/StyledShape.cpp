@@ -0,0 +1,143 @@
+#include "StyledShape.hpp"
+#include "GUIFrame.hpp"
+
+using namespace gui;
+
+StyledShape::StyledShape()
+{
+	m_style = Style::getDefault();
+	m_themeVersion = 0;
+	m_ownsStyle = false;
+	m_hasFillOverride = false;
+	m_restScale = sf::Vector2f(1, 1);
+	invalidateMeshes();
+}
+Style::State StyledShape::getState(const Entity& entity)
+{
+	return !entity.isSelected() ? Style::NORMAL : entity.isPressed() ? Style::PRESSED : Style::HOVER;
+}
+void StyledShape::applyLook(Entity& entity)
+{
+	// geometry of the state is already built, only the scale changes
+	Style::State state = getState(entity);
+	if (state != Style::NORMAL)scaleTo(entity, getLook(state).scale);
+	entity.invalidate();
+}
+void StyledShape::saveRestScale(const Entity& entity)
+{
+	// while easing back to the rest scale, the rest scale is unchanged
+	Animator* animator = entity.getAnimator();
+	bool restoring = animator != nullptr && animator->isAnimating(entity, Animator::Property::SCALE);
+	if (!entity.isSelected() && !restoring)m_restScale = entity.getScale();
+}
+void StyledShape::restoreRestScale(Entity& entity)
+{
+	if (entity.isSelected())scaleTo(entity, m_restScale);
+}
+void StyledShape::scaleTo(Entity& entity, const sf::Vector2f& scale)
+{
+	Animator* animator = entity.getAnimator();
+	if (animator != nullptr)animator->animateScale(entity, scale, getStyle()->getTransitionDuration(), getStyle()->getTransitionEasing());
+	else entity.setScale(scale);
+}
+const RenderBatch::Mesh& StyledShape::getMesh(const Entity& entity, const sf::Shape& shape) const
+{
+	// a swapped theme changes the looks of every state
+	if (m_theme != nullptr && m_theme->getVersion() != m_themeVersion) {
+		for (int i = 0; i < Style::STATE_COUNT; i++)m_meshValid[i] = false;
+		m_themeVersion = m_theme->getVersion();
+	}
+
+	Style::State state = getState(entity);
+	if (!m_meshValid[state]) {
+		const Style::Look& look = getLook(state);
+		m_meshes[state].build(shape, look.fillColor, look.outlineColor, look.outlineThickness);
+		m_meshValid[state] = true;
+	}
+	return m_meshes[state];
+}
+void StyledShape::submit(RenderBatch& batch, const Entity& entity, const sf::Shape& shape, const sf::RenderStates& states) const
+{
+	const RenderBatch::Mesh& mesh = getMesh(entity, shape);
+	if (m_hasFillOverride && getState(entity) == Style::NORMAL)batch.add(mesh, m_fillOverride, states);
+	else batch.add(mesh, states);
+}
+void StyledShape::setFillOverride(Entity& entity, const sf::Color& color)
+{
+	m_fillOverride = color;
+	m_hasFillOverride = true;
+	entity.invalidate();
+}
+void StyledShape::clearFillOverride(Entity& entity)
+{
+	if (!m_hasFillOverride)return;
+	m_hasFillOverride = false;
+	entity.invalidate();
+}
+sf::Color StyledShape::getFillColor() const
+{
+	return m_hasFillOverride ? m_fillOverride : getLook(Style::NORMAL).fillColor;
+}
+void StyledShape::invalidateMeshes()
+{
+	for (int i = 0; i < Style::STATE_COUNT; i++)m_meshValid[i] = false;
+}
+void StyledShape::restyle(Entity& entity, bool selection, const std::function<void(Style::Look&)>& change)
+{
+	Style& style = ownStyle();
+	for (int i = 0; i < Style::STATE_COUNT; i++) {
+		Style::State state = (Style::State)i;
+		if ((state != Style::NORMAL) != selection)continue;
+
+		Style::Look look = style.getLook(state);
+		change(look);
+		style.setLook(state, look);
+	}
+	invalidateMeshes();
+	applyLook(entity);
+}
+void StyledShape::setTransition(sf::Time duration, Animator::Easing easing)
+{
+	ownStyle().setTransition(duration, easing);
+}
+Style& StyledShape::ownStyle()
+{
+	// the style may be shared or be that of a theme, other widgets keep it unchanged
+	if (!m_ownsStyle || m_style.use_count() > 1) {
+		m_style = std::make_shared<Style>(*getStyle());
+		m_theme = nullptr;
+		m_ownsStyle = true;
+	}
+
+	// created non const by the copy above
+	return const_cast<Style&>(*m_style);
+}
+void StyledShape::setStyle(Entity& entity, const std::shared_ptr<const Style>& style)
+{
+	m_style = style;
+	m_theme = nullptr;
+	m_ownsStyle = false;
+	invalidateMeshes();
+	applyLook(entity);
+}
+void StyledShape::setTheme(Entity& entity, const std::shared_ptr<const Theme>& theme)
+{
+	m_theme = theme;
+	m_themeVersion = theme->getVersion();
+	m_style = nullptr;
+	m_ownsStyle = false;
+	invalidateMeshes();
+	applyLook(entity);
+}
+const std::shared_ptr<const Theme>& StyledShape::getTheme() const
+{
+	return m_theme;
+}
+const std::shared_ptr<const Style>& StyledShape::getStyle() const
+{
+	return m_theme != nullptr ? m_theme->getStyle() : m_style;
+}
+const Style::Look& StyledShape::getLook(Style::State state) const
+{
+	return getStyle()->getLook(state);
+}
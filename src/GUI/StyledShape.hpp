@@ -0,0 +1,212 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include "RenderBatch.hpp"
+#include "Style.hpp"
+#include <functional>
+#include <memory>
+
+namespace gui {
+
+class Entity;
+
+////////////////////////////////////////////////////////////
+/// \brief Style of a widget shape and the geometry of the shape
+///		   in every state, shared by buttons and text buttons
+///
+/// The helper does not own the entity nor the shape, every
+/// function taking them is given those of the widget holding
+/// the helper, so copying a widget copies a valid helper.
+///
+////////////////////////////////////////////////////////////
+class StyledShape {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Default constructor, the default style is used
+	///
+	////////////////////////////////////////////////////////////
+	StyledShape();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the state whose look is shown by an entity
+	///
+	////////////////////////////////////////////////////////////
+	static Style::State getState(const Entity& entity);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Apply the look of the current state, its geometry is
+	///		   built once and reused until the shape or style changes
+	///
+	/// \param entity -> Widget holding the helper
+	///
+	////////////////////////////////////////////////////////////
+	void applyLook(Entity& entity);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Remember the scale of the widget before it is selected
+	///
+	/// Nothing is remembered while the widget is selected or easing
+	/// back to the scale remembered last.
+	///
+	/// \param entity -> Widget holding the helper
+	///
+	////////////////////////////////////////////////////////////
+	void saveRestScale(const Entity& entity);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Scale a selected widget back to the scale remembered
+	///		   before its selection
+	///
+	/// \param entity -> Widget holding the helper
+	///
+	////////////////////////////////////////////////////////////
+	void restoreRestScale(Entity& entity);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the geometry of the shape in the current state,
+	///		   built the first time it is needed
+	///
+	/// \param entity -> Widget holding the helper
+	/// \param shape -> Points and texture of the widget
+	///
+	////////////////////////////////////////////////////////////
+	const RenderBatch::Mesh& getMesh(const Entity& entity, const sf::Shape& shape) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Add the geometry of the current state to the batch,
+	///		   with the fill override in the normal state
+	///
+	/// \param batch -> Batch collecting the geometry
+	/// \param entity -> Widget holding the helper
+	/// \param shape -> Points and texture of the widget
+	/// \param states -> Render states of the widget
+	///
+	////////////////////////////////////////////////////////////
+	void submit(RenderBatch& batch, const Entity& entity, const sf::Shape& shape, const sf::RenderStates& states) const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show a fill color in the normal state in place of that
+	///		   of the style, until the fill color is set or cleared
+	///
+	/// Neither the style nor the geometry change, the color is
+	/// applied when the geometry is added to the batch. Animations
+	/// of the fill color go through it every frame.
+	///
+	/// \param entity -> Widget holding the helper
+	/// \param color -> Fill color of the normal state
+	///
+	////////////////////////////////////////////////////////////
+	void setFillOverride(Entity& entity, const sf::Color& color);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show the fill color of the style again
+	///
+	/// \param entity -> Widget holding the helper
+	///
+	////////////////////////////////////////////////////////////
+	void clearFillOverride(Entity& entity);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the fill color shown in the normal state, the
+	///		   override if one is set
+	///
+	////////////////////////////////////////////////////////////
+	sf::Color getFillColor() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Mark the geometry of every state to be built again
+	///
+	////////////////////////////////////////////////////////////
+	void invalidateMeshes();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change looks on a copy of the style owned by this widget
+	///
+	/// \param entity -> Widget holding the helper
+	/// \param selection -> true to change the hover and pressed looks, false the normal look
+	/// \param change -> Applied to every changed look
+	///
+	////////////////////////////////////////////////////////////
+	void restyle(Entity& entity, bool selection, const std::function<void(Style::Look&)>& change);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Ease the scale of the widget when its state changes
+	///
+	/// \param duration -> Duration of the change of scale, zero to set it at once
+	/// \param easing -> Curve of the change of scale
+	///
+	////////////////////////////////////////////////////////////
+	void setTransition(sf::Time duration, Animator::Easing easing);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the looks of the widget in every state
+	///
+	/// \param entity -> Widget holding the helper
+	/// \param style -> New style, must not be nullptr
+	///
+	////////////////////////////////////////////////////////////
+	void setStyle(Entity& entity, const std::shared_ptr<const Style>& style);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show the style of a theme until a look or style is set
+	///
+	/// \param entity -> Widget holding the helper
+	/// \param theme -> Theme to follow, must not be nullptr
+	///
+	////////////////////////////////////////////////////////////
+	void setTheme(Entity& entity, const std::shared_ptr<const Theme>& theme);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the theme followed by the widget
+	///
+	/// \return Theme of the widget, nullptr if it has its own style
+	///
+	////////////////////////////////////////////////////////////
+	const std::shared_ptr<const Theme>& getTheme() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the looks of the widget in every state, those
+	///		   of its theme if it follows one
+	///
+	////////////////////////////////////////////////////////////
+	const std::shared_ptr<const Style>& getStyle() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the look of a state
+	///
+	////////////////////////////////////////////////////////////
+	const Style::Look& getLook(Style::State state) const;
+
+private:
+	////////////////////////////////////////////////////////////
+	/// \brief Scale the widget, eased by the animator of its frame
+	///		   if the style has a transition
+	///
+	////////////////////////////////////////////////////////////
+	void scaleTo(Entity& entity, const sf::Vector2f& scale);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get a style only this widget holds, copied from the
+	///		   current one unless the widget already owns it alone
+	///
+	////////////////////////////////////////////////////////////
+	Style& ownStyle();
+
+
+	////////////////////////////////////////////////////////////
+	// Member data
+	////////////////////////////////////////////////////////////
+
+	std::shared_ptr<const Style> m_style;					/// < looks of the shape in every state, may be shared, unused with a theme
+	std::shared_ptr<const Theme> m_theme;					/// < theme followed by the widget, nullptr if it has its own style
+	mutable unsigned int m_themeVersion;					/// < version of the theme the geometry was built with
+	bool m_ownsStyle;										/// < whether m_style is a copy made by the widget, changed in place while unshared
+	sf::Color m_fillOverride;								/// < fill color of the normal state replacing that of the style
+	bool m_hasFillOverride;									/// < whether m_fillOverride is shown
+	sf::Vector2f m_restScale;								/// < scale set on the widget, restored when deselected
+	mutable RenderBatch::Mesh m_meshes[Style::STATE_COUNT];	/// < geometry of the shape in every state
+	mutable bool m_meshValid[Style::STATE_COUNT];			/// < whether the geometry of a state is up to date
+};
+
+} // namespace gui
@@ -7,75 +7,120 @@ TextButton::TextButton(const sf::Vector2f& size):
 {
 	actionEvent = ActionEvent::RELEASE;
 
-	m_second_ScaleFactor.x = m_second_ScaleFactor.y = 1;
-	m_second_OutlineThickness = 0;
-	m_second_FillColor = sf::Color::White;
-	m_second_OutlineColor = sf::Color::White;
+	m_look.applyLook(*this);
 }
 
-void TextButton::switchProperties()
+void TextButton::setBoxFillColor(const sf::Color& color)
 {
-	auto fillColor = m_box.getFillColor();
-	auto outlineColor = m_box.getOutlineColor();
-	auto outlineThickness = m_box.getOutlineThickness();
-	auto scaleFactor = getScale();
-
-	m_box.setFillColor(m_second_FillColor);
-	m_box.setOutlineColor(m_second_OutlineColor);
-	m_box.setOutlineThickness(m_second_OutlineThickness);
-	setScale(m_second_ScaleFactor);
-
-	m_second_FillColor = fillColor;
-	m_second_OutlineColor = outlineColor;
-	m_second_OutlineThickness = outlineThickness;
-	m_second_ScaleFactor = scaleFactor;
+	m_look.clearFillOverride(*this);
+	m_look.restyle(*this, false, [&color](Style::Look& look) { look.fillColor = color; });
 }
-
-void TextButton::setBoxFillColor(const sf::Color& color)
+void TextButton::setFillOverride(const sf::Color& color)
 {
-	if (m_selected) m_second_FillColor = color;
-	else m_box.setFillColor(color);
+	m_look.setFillOverride(*this, color);
+}
+void TextButton::clearFillOverride()
+{
+	m_look.clearFillOverride(*this);
 }
 void TextButton::setBoxOutlineColor(const sf::Color& color)
 {
-	if (m_selected) m_second_OutlineColor = color;
-	else m_box.setOutlineColor(color);
+	m_look.restyle(*this, false, [&color](Style::Look& look) { look.outlineColor = color; });
 }
 void TextButton::setBoxOutlineThickness(float thickness)
 {
-	if (m_selected) m_second_OutlineThickness = thickness;
-	else m_box.setOutlineThickness(thickness);
+	m_look.restyle(*this, false, [thickness](Style::Look& look) { look.outlineThickness = thickness; });
+}
+void TextButton::setSize(const sf::Vector2f& size)
+{
+	Textbox::setSize(size);
+	m_look.invalidateMeshes();
+}
+void TextButton::setTexture(const sf::Texture* texture, bool resetRect)
+{
+	Textbox::setTexture(texture, resetRect);
+	m_look.invalidateMeshes();
+}
+void TextButton::setTextureRect(const sf::IntRect& rect)
+{
+	Textbox::setTextureRect(rect);
+	m_look.invalidateMeshes();
+}
+sf::Color TextButton::getBoxFillColor() const
+{
+	return m_look.getFillColor();
+}
+sf::Color TextButton::getBoxOutlineColor() const
+{
+	return m_look.getLook(Style::NORMAL).outlineColor;
+}
+float TextButton::getBoxOutlineThickness() const
+{
+	return m_look.getLook(Style::NORMAL).outlineThickness;
 }
 void TextButton::setSelectionFillColor(const sf::Color& color)
 {
-	if (m_selected) m_box.setFillColor(color);
-	else m_second_FillColor = color;
+	m_look.restyle(*this, true, [&color](Style::Look& look) { look.fillColor = color; });
 }
 void TextButton::setSelectionOutlineColor(const sf::Color& color)
 {
-	if (m_selected) m_box.setOutlineColor(color);
-	else m_second_OutlineColor = color;
+	m_look.restyle(*this, true, [&color](Style::Look& look) { look.outlineColor = color; });
 }
 void TextButton::setSelectionOutlineThickness(float thickness)
 {
-	if (m_selected) m_box.setOutlineThickness(thickness);
-	else m_second_OutlineThickness = thickness;
+	m_look.restyle(*this, true, [thickness](Style::Look& look) { look.outlineThickness = thickness; });
 }
 void TextButton::setSelectionScale(const sf::Vector2f& scaleFactor)
 {
-	if (m_selected) setScale(scaleFactor);
-	else m_second_ScaleFactor = scaleFactor;
+	m_look.restyle(*this, true, [&scaleFactor](Style::Look& look) { look.scale = scaleFactor; });
+}
+void TextButton::setSelectionTransition(sf::Time duration, Animator::Easing easing)
+{
+	m_look.setTransition(duration, easing);
+}
+void TextButton::setButtonStyle(const std::shared_ptr<const Style>& style)
+{
+	m_look.setStyle(*this, style);
+}
+void TextButton::setButtonTheme(const std::shared_ptr<const Theme>& theme)
+{
+	m_look.setTheme(*this, theme);
+}
+const std::shared_ptr<const Style>& TextButton::getButtonStyle() const
+{
+	return m_look.getStyle();
+}
+const std::shared_ptr<const Theme>& TextButton::getButtonTheme() const
+{
+	return m_look.getTheme();
+}
+sf::FloatRect TextButton::getBoxBounds() const
+{
+	return m_look.getMesh(*this, m_box).bounds;
+}
+void TextButton::submitBox(RenderBatch& batch, const sf::RenderStates& states) const
+{
+	m_look.submit(batch, *this, m_box, states);
 }
 void TextButton::activateSelection()
 {
+	m_look.saveRestScale(*this);
 	m_selected = true;
-	switchProperties();
+	m_look.applyLook(*this);
 }
 void TextButton::deactivateSelection()
 {
+	m_look.restoreRestScale(*this);
 	m_selected = false;
-	switchProperties();
+	m_look.applyLook(*this);
+}
+void TextButton::activatePress()
+{
+	m_pressed = true;
+	m_look.applyLook(*this);
+}
+void TextButton::deactivatePress()
+{
+	m_pressed = false;
+	m_look.applyLook(*this);
 }
-
-
-
@@ -2,6 +2,7 @@
 
 #include "GUIFrame.hpp"
 #include "Textbox.hpp"
+#include "StyledShape.hpp"
 
 namespace gui {
 class TextButton : public Textbox {
@@ -25,6 +26,24 @@ public:
 	////////////////////////////////////////////////////////////
 	void setBoxFillColor(const sf::Color& color) override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Show a fill color when the box is not selected,
+	///		   without changing the style of the button
+	///
+	/// Cheap enough to be called every frame, the animator fades
+	/// the fill color through it. Setting the fill color clears it.
+	/// 
+	/// \param color -> fill color shown in place of that of the style
+	///
+	////////////////////////////////////////////////////////////
+	void setFillOverride(const sf::Color& color);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show the fill color of the style again
+	///
+	////////////////////////////////////////////////////////////
+	void clearFillOverride();
+
 	////////////////////////////////////////////////////////////
 	/// \brief Set the outline color of the box
 	///
@@ -48,6 +67,55 @@ public:
 	////////////////////////////////////////////////////////////
 	void setBoxOutlineThickness(float thickness) override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Set the size of the box
+	///
+	/// \param size -> New size
+	///
+	////////////////////////////////////////////////////////////
+	void setSize(const sf::Vector2f& size) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Change the source texture of the box
+	///
+	/// \param texture -> New texture
+	/// \param resetRect -> Should the texture rect be reset to the size of the new texture?
+	///
+	////////////////////////////////////////////////////////////
+	void setTexture(const sf::Texture* texture, bool resetRect = false) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the sub-rectangle of the texture that the box will display
+	///
+	/// \param rect -> Rectangle defining the region of the texture to display
+	///
+	////////////////////////////////////////////////////////////
+	void setTextureRect(const sf::IntRect& rect) override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the fill color of the box when not selected
+	///
+	/// \return fill color of the box, the override if one is set
+	///
+	////////////////////////////////////////////////////////////
+	sf::Color getBoxFillColor() const override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the outline color of the box when not selected
+	///
+	/// \return outline color of the box
+	///
+	////////////////////////////////////////////////////////////
+	sf::Color getBoxOutlineColor() const override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the thickness of the box's outline when not selected
+	///
+	/// \return outline thickness, in pixels
+	///
+	////////////////////////////////////////////////////////////
+	float getBoxOutlineThickness() const override;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Set the color of the button box upon selection
 	/// 
@@ -80,6 +148,54 @@ public:
 	////////////////////////////////////////////////////////////
 	void setSelectionScale(const sf::Vector2f& scaleFactor);
 
+	////////////////////////////////////////////////////////////
+	/// \brief Ease the scale of the box when it is selected, pressed or deselected
+	/// 
+	/// \param duration -> duration of the change of scale, zero to set it at once
+	/// \param easing -> curve of the change of scale
+	///
+	////////////////////////////////////////////////////////////
+	void setSelectionTransition(sf::Time duration, Animator::Easing easing = Animator::Easing::SMOOTH);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the looks of the box in every state
+	///
+	/// The style is shared, not copied : widgets with the same
+	/// style hold the same object. Look setters afterwards give
+	/// this button its own modified copy.
+	/// 
+	/// \param style -> new style, must not be nullptr
+	///
+	////////////////////////////////////////////////////////////
+	void setButtonStyle(const std::shared_ptr<const Style>& style);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Show the style of a theme, swapped with the theme
+	///
+	/// The button follows the theme until a style is set or a
+	/// look setter gives it its own copy of the style.
+	/// 
+	/// \param theme -> theme to follow, must not be nullptr
+	///
+	////////////////////////////////////////////////////////////
+	void setButtonTheme(const std::shared_ptr<const Theme>& theme);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the looks of the box in every state
+	/// 
+	/// \return style of the button, possibly shared with other widgets
+	///
+	////////////////////////////////////////////////////////////
+	const std::shared_ptr<const Style>& getButtonStyle() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the theme followed by the button
+	/// 
+	/// \return theme of the button, nullptr if it has its own style
+	///
+	////////////////////////////////////////////////////////////
+	const std::shared_ptr<const Theme>& getButtonTheme() const;
+
 	////////////////////////////////////////////////////////////
 	/// \brief Actions to take upon selection of the object
 	///
@@ -92,33 +208,47 @@ public:
 	////////////////////////////////////////////////////////////
 	virtual void deactivateSelection() override;
 
+	////////////////////////////////////////////////////////////
+	/// \brief Actions to take when the left button is pressed on the object
+	///
+	////////////////////////////////////////////////////////////
+	virtual void activatePress() override;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Actions to take when the press on the object ends
+	///
+	////////////////////////////////////////////////////////////
+	virtual void deactivatePress() override;
+
 	void setInputEnabled(bool) = delete;
 	bool isInputEnabled() = delete;
 	void setNewLineEnabled(bool) = delete;
 	bool isNewLineEnabled() = delete;
 
-private:
-
+protected:
 	////////////////////////////////////////////////////////////
-	/// \brief switch properties of shape with second properties
+	/// \brief Get the rectangle covered by the box and its outline
+	///		   in the current state
 	///
 	////////////////////////////////////////////////////////////
-	void switchProperties();
-
+	sf::FloatRect getBoxBounds() const override;
 
 	////////////////////////////////////////////////////////////
-	// Member data
+	/// \brief Add the cached geometry of the current state to the batch
+	/// 
+	/// \param batch -> Batch collecting the geometry
+	/// \param states -> Render states of the object
+	/// 
 	////////////////////////////////////////////////////////////
+	void submitBox(RenderBatch& batch, const sf::RenderStates& states) const override;
+
+private:
 
 	////////////////////////////////////////////////////////////
-	/// \brief Property to change how button looks based on selection and deselection
-	/// 
+	// Member data
 	////////////////////////////////////////////////////////////
-	
-	sf::Color m_second_FillColor;						/// < second color of the box
-	sf::Color m_second_OutlineColor;					/// < second color of the outline of the box
-	float m_second_OutlineThickness;					/// < second thickness of the outline of the box
-	sf::Vector2f m_second_ScaleFactor;					/// < second scale factor of the shape
+
+	StyledShape m_look;									/// < style and geometry of the box in every state
 };
 
 } // namespace gui
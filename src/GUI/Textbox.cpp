@@ -46,6 +46,7 @@ bool gui::Textbox::isNewLineEnabled()
 void Textbox::setSize(const sf::Vector2f& size)
 {
 	m_box.setSize(size);
+	invalidate();
 }
 
 const sf::Vector2f& Textbox::getSize() const
@@ -56,62 +57,77 @@ const sf::Vector2f& Textbox::getSize() const
 void Textbox::setString(const std::string& string)
 {
 	m_text.setString(string);
+	invalidate();
 }
 void Textbox::setFont(const sf::Font& font)
 {
 	m_text.setFont(font);
+	invalidate();
 }
 void Textbox::setCharacterSize(unsigned int size)
 {
 	m_text.setCharacterSize(size);
+	invalidate();
 }
 void Textbox::setLineSpacing(float spacingFactor)
 {
 	m_text.setLineSpacing(spacingFactor);
+	invalidate();
 }
 void Textbox::setLetterSpacing(float spacingFactor)
 {
 	m_text.setLetterSpacing(spacingFactor);
+	invalidate();
 }
 void Textbox::setStyle(sf::Uint32 style)
 {
 	m_text.setStyle(style);
+	invalidate();
 }
 void Textbox::setBoxFillColor(const sf::Color& color)
 {
 	m_box.setFillColor(color);
+	invalidate();
 }
 void Textbox::setBoxOutlineColor(const sf::Color& color)
 {
 	m_box.setOutlineColor(color);
+	invalidate();
 }
 void Textbox::setBoxOutlineThickness(float thickness)
 {
 	m_box.setOutlineThickness(thickness);
+	invalidate();
 }
 void Textbox::setTexture(const sf::Texture* texture, bool resetRect)
 {
 	m_box.setTexture(texture, resetRect);
+	invalidate();
 }
 void Textbox::setTextureRect(const sf::IntRect& rect)
 {
 	m_box.setTextureRect(rect);
+	invalidate();
 }
 void Textbox::setTextFillColor(const sf::Color& color)
 {
 	m_text.setFillColor(color);
+	invalidate();
 }
 void Textbox::setTextOutlineColor(const sf::Color& color)
 {
 	m_text.setOutlineColor(color);
+	invalidate();
 }
 void Textbox::setTextOutlineThickness(float thickness)
 {
 	m_text.setOutlineThickness(thickness);
+	invalidate();
 }
 void Textbox::clearString()
 {
 	m_text.setString("");
+	invalidate();
 }
 std::string Textbox::getString() const
 {
@@ -137,11 +153,11 @@ sf::Uint32 Textbox::getStyle() const
 {
 	return m_text.getStyle();
 }
-const sf::Color& Textbox::getBoxFillColor() const
+sf::Color Textbox::getBoxFillColor() const
 {
 	return m_box.getFillColor();
 }
-const sf::Color& Textbox::getBoxOutlineColor() const
+sf::Color Textbox::getBoxOutlineColor() const
 {
 	return m_box.getOutlineColor();
 }
@@ -181,9 +197,28 @@ sf::FloatRect Textbox::getGlobalBounds() const
 {
 	return getTransform().transformRect(getLocalBounds());
 }
+sf::FloatRect Textbox::getDrawBounds() const
+{
+	// text is translated w.r.t box the same way as in draw
+	sf::FloatRect textBounds = m_text.getGlobalBounds();
+	textBounds.left += (m_box.getSize().x - textBounds.width) * 0.5f * (int)m_alignment;
+	textBounds.top += m_box.getSize().y * 0.5f - textBounds.height;
+
+	// bounds of the box include its outline
+	return getTransform().transformRect(uniteRects(getBoxBounds(), textBounds));
+}
+sf::FloatRect Textbox::getBoxBounds() const
+{
+	return m_box.getGlobalBounds();
+}
+void Textbox::submitBox(RenderBatch& batch, const sf::RenderStates& states) const
+{
+	batch.add(m_box, states);
+}
 void Textbox::alignText(TextAlign textAlign)
 {
 	m_alignment = textAlign;
+	invalidate();
 }
 
 bool Textbox::contains(const sf::Vector2f& point) const
@@ -201,18 +236,20 @@ Entity* Textbox::isHit(const sf::Vector2f& point)
 void Textbox::activateSelection()
 {
 	m_selected = true;
+	invalidate();
 }
 void Textbox::deactivateSelection()
 {
 	m_selected = false;
+	invalidate();
 }
 
-void Textbox::draw(sf::RenderTarget& target, sf::RenderStates states) const
+void Textbox::submit(RenderBatch& batch, sf::RenderStates states) const
 {
 	if (isActive()) {
 		// apply tarnsform to box
 		states.transform *= getTransform();
-		target.draw(m_box, states);
+		submitBox(batch, states);
 
 		// apply transform to text
 		// since translation is last operation, text is translated w.r.t box
@@ -220,7 +257,7 @@ void Textbox::draw(sf::RenderTarget& target, sf::RenderStates states) const
 			(m_box.getSize().x - m_text.getGlobalBounds().width) * 0.5f * (int)m_alignment,
 			m_box.getSize().y * 0.5f - m_text.getGlobalBounds().height
 		);
-		target.draw(m_text, states);
+		batch.add(m_text, states);
 	}
 }
 
@@ -216,7 +216,7 @@ public:
     /// \param resetRect Should the texture rect be reset to the size of the new texture?
     ///
     ////////////////////////////////////////////////////////////
-    void setTexture(const sf::Texture* texture, bool resetRect = false);
+    virtual void setTexture(const sf::Texture* texture, bool resetRect = false);
 
     ////////////////////////////////////////////////////////////
     /// \brief Set the sub-rectangle of the texture that the shape will display
@@ -228,7 +228,7 @@ public:
     /// \param rect Rectangle defining the region of the texture to display
     ///
     ////////////////////////////////////////////////////////////
-    void setTextureRect(const sf::IntRect& rect);
+    virtual void setTextureRect(const sf::IntRect& rect);
 
     ////////////////////////////////////////////////////////////
     /// \brief Set the fill color of the text
@@ -328,7 +328,7 @@ public:
     ///
     ////////////////////////////////////////////////////////////
 
-    const sf::Color& getBoxFillColor() const;
+    virtual sf::Color getBoxFillColor() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get the outline color of the box
@@ -336,7 +336,7 @@ public:
     /// \return Outline color of the box
     ///
     ////////////////////////////////////////////////////////////
-    const sf::Color& getBoxOutlineColor() const;
+    virtual sf::Color getBoxOutlineColor() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get the outline thickness of the box
@@ -344,7 +344,7 @@ public:
     /// \return Outline thickness of the box, in pixels
     ///
     ////////////////////////////////////////////////////////////
-    float getBoxOutlineThickness() const;
+    virtual float getBoxOutlineThickness() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get the source texture of the shape
@@ -475,13 +475,39 @@ public:
     virtual void deactivateSelection() override;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Draws the object to the target applying its states
+    /// \brief Get the rectangle covered by everything the object draws
+    ///
+    /// \return Bounding rectangle of the drawn object in the coordinate
+    ///            system of the functional parent
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual sf::FloatRect getDrawBounds() const override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the geometry of the object to the batch applying its states
     /// 
-    /// \param target -> Render target to draw to
+    /// \param batch -> Batch collecting the geometry
     /// \param states -> Current render states
     /// 
     ////////////////////////////////////////////////////////////
-    virtual void draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const override;
+    virtual void submit(RenderBatch& batch, sf::RenderStates states = sf::RenderStates::Default) const override;
+
+protected:
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rectangle covered by the box and its outline
+    ///        in local coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual sf::FloatRect getBoxBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the geometry of the box to the batch
+    /// 
+    /// \param batch -> Batch collecting the geometry
+    /// \param states -> Render states of the object
+    /// 
+    ////////////////////////////////////////////////////////////
+    virtual void submitBox(RenderBatch& batch, const sf::RenderStates& states) const;
 
 
     ////////////////////////////////////////////////////////////
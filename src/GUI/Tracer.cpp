@@ -0,0 +1,133 @@
+#include "Tracer.hpp"
+#include "GUIFrame.hpp"
+
+#include <fstream>
+
+using namespace gui;
+
+// default number of spans kept, about a hundred frames of a busy scene
+static const std::size_t defaultCapacity = 1 << 16;
+
+static void writeEscaped(std::ostream& out, const std::string& string)
+{
+	for (char c : string) {
+		if (c == '"' || c == '\\')out << '\\' << c;
+		else if ((unsigned char)c < 0x20)out << ' ';
+		else out << c;
+	}
+}
+
+////////////////////////////////////////////////////////////
+// Span
+////////////////////////////////////////////////////////////
+
+Tracer::Span::Span(const char* label, unsigned long long id)
+{
+	m_label = label;
+	m_id = id;
+	m_start = Tracer::get().isEnabled() ? Tracer::get().getTime() : -1;
+}
+
+Tracer::Span::~Span()
+{
+	if (m_start < 0)return;
+
+	Tracer& tracer = Tracer::get();
+	tracer.record(m_label, m_id, m_start, tracer.getTime() - m_start);
+}
+
+////////////////////////////////////////////////////////////
+// Tracer
+////////////////////////////////////////////////////////////
+
+Tracer::Tracer()
+{
+	m_events.resize(defaultCapacity);
+	m_next = 0;
+	m_full = false;
+	m_enabled = true;
+	m_origin = std::chrono::steady_clock::now();
+}
+
+Tracer& Tracer::get()
+{
+	static Tracer tracer;
+	return tracer;
+}
+
+void Tracer::setEnabled(bool enable)
+{
+	m_enabled = enable;
+}
+
+bool Tracer::isEnabled() const
+{
+	return m_enabled;
+}
+
+void Tracer::setCapacity(std::size_t capacity)
+{
+	m_events.assign(capacity > 0 ? capacity : 1, Event());
+	clear();
+}
+
+void Tracer::clear()
+{
+	m_next = 0;
+	m_full = false;
+}
+
+std::size_t Tracer::getSize() const
+{
+	return m_full ? m_events.size() : m_next;
+}
+
+void Tracer::record(const char* label, unsigned long long id, sf::Int64 start, sf::Int64 duration)
+{
+	if (!m_enabled)return;
+
+	m_events[m_next] = { label, id, start, duration };
+	if (++m_next == m_events.size()) {
+		m_next = 0;
+		m_full = true;
+	}
+}
+
+sf::Int64 Tracer::getTime() const
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_origin).count();
+}
+
+bool Tracer::saveToFile(const std::string& filename, const Frame* frame) const
+{
+	std::ofstream file(filename);
+	if (!file)return false;
+
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	// oldest span first
+	std::size_t count = getSize();
+	std::size_t first = m_full ? m_next : 0;
+	for (std::size_t i = 0; i < count; i++) {
+		const Event& event = m_events[(first + i) % m_events.size()];
+
+		std::string name = event.id != 0 && frame != nullptr ? frame->getName(event.id) : "";
+		file << "{\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << event.start << ",\"dur\":" << event.duration << ",\"name\":\"";
+		writeEscaped(file, name.empty() ? event.label : std::string(event.label) + " " + name);
+		file << "\"";
+		if (event.id != 0) {
+			// Ids exceed the integers a double holds exactly, viewers parse numbers as doubles
+			file << ",\"args\":{\"id\":\"" << event.id << "\"";
+			if (!name.empty()) {
+				file << ",\"name\":\"";
+				writeEscaped(file, name);
+				file << "\"";
+			}
+			file << "}";
+		}
+		file << "}" << (i + 1 < count ? ",\n" : "\n");
+	}
+
+	file << "]}\n";
+	return (bool)file;
+}
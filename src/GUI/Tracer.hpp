@@ -0,0 +1,152 @@
+#pragma once
+
+#include <SFML/Config.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////
+/// Tracing macros
+///
+/// Define GUI_TRACING to record spans of the gui in the global
+/// tracer. Without it the macros expand to nothing.
+///
+////////////////////////////////////////////////////////////
+#ifdef GUI_TRACING
+#define GUI_TRACE_CONCAT_IMPL(a, b) a##b
+#define GUI_TRACE_CONCAT(a, b) GUI_TRACE_CONCAT_IMPL(a, b)
+#define GUI_TRACE_SCOPE(label) gui::Tracer::Span GUI_TRACE_CONCAT(guiTraceSpan, __LINE__)(label)
+#define GUI_TRACE_ENTITY(label, entity) gui::Tracer::Span GUI_TRACE_CONCAT(guiTraceSpan, __LINE__)(label, (entity).getID())
+#else
+#define GUI_TRACE_SCOPE(label)
+#define GUI_TRACE_ENTITY(label, entity)
+#endif
+
+namespace gui {
+
+class Frame;
+
+////////////////////////////////////////////////////////////
+/// \brief Ring buffer of timed spans exported as Chrome trace events
+///
+/// Spans are recorded when they end, the oldest are overwritten once
+/// the buffer is full. Names of entities are looked up in the name
+/// registry of a Frame when the trace is saved, not while recording.
+/// The saved file opens in chrome://tracing and ui.perfetto.dev.
+///
+////////////////////////////////////////////////////////////
+class Tracer {
+public:
+
+	////////////////////////////////////////////////////////////
+	/// \brief Records a span from construction to destruction
+	///
+	////////////////////////////////////////////////////////////
+	class Span {
+	public:
+
+		////////////////////////////////////////////////////////////
+		/// \brief Start a span
+		///
+		/// \param label -> Name of the span, must be a string literal
+		/// \param id -> gui Id of the entity the span belongs to, 0 if none
+		///
+		////////////////////////////////////////////////////////////
+		Span(const char* label, unsigned long long id = 0);
+		~Span();
+
+	private:
+		const char* m_label;	/// < name of the span
+		unsigned long long m_id;	/// < gui Id of the entity
+		sf::Int64 m_start;		/// < start in microseconds, negative if the tracer was disabled
+	};
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the tracer used by the gui
+	///
+	////////////////////////////////////////////////////////////
+	static Tracer& get();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Enable or disable recording, enabled by default
+	///
+	////////////////////////////////////////////////////////////
+	void setEnabled(bool enable);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Check if spans are recorded
+	///
+	////////////////////////////////////////////////////////////
+	bool isEnabled() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Set the number of spans kept, discards recorded spans
+	///
+	////////////////////////////////////////////////////////////
+	void setCapacity(std::size_t capacity);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Discard recorded spans
+	///
+	////////////////////////////////////////////////////////////
+	void clear();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the number of recorded spans
+	///
+	////////////////////////////////////////////////////////////
+	std::size_t getSize() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Record a span which has ended
+	///
+	/// \param label -> Name of the span, must be a string literal
+	/// \param id -> gui Id of the entity, 0 if none
+	/// \param start -> Start in microseconds, from getTime
+	/// \param duration -> Duration in microseconds
+	///
+	////////////////////////////////////////////////////////////
+	void record(const char* label, unsigned long long id, sf::Int64 start, sf::Int64 duration);
+
+	////////////////////////////////////////////////////////////
+	/// \brief Get the time of the tracer in microseconds
+	///
+	////////////////////////////////////////////////////////////
+	sf::Int64 getTime() const;
+
+	////////////////////////////////////////////////////////////
+	/// \brief Write the recorded spans as trace event JSON
+	///
+	/// The Id of an entity is written as a decimal string, as a
+	/// JSON number it would be rounded by trace viewers.
+	///
+	/// \param filename -> Path of the file
+	/// \param frame -> Frame whose names label the spans, can be nullptr
+	///
+	/// \return true if the file was written
+	///
+	////////////////////////////////////////////////////////////
+	bool saveToFile(const std::string& filename, const Frame* frame = nullptr) const;
+
+private:
+	Tracer();
+
+	////////////////////////////////////////////////////////////
+	/// \brief Recorded span
+	///
+	////////////////////////////////////////////////////////////
+	struct Event {
+		const char* label;		/// < name of the span
+		unsigned long long id;	/// < gui Id of the entity, 0 if none
+		sf::Int64 start;		/// < start in microseconds
+		sf::Int64 duration;		/// < duration in microseconds
+	};
+
+	std::vector<Event> m_events;							/// < ring buffer of spans
+	std::size_t m_next;										/// < slot of the next span
+	bool m_full;											/// < whether the ring buffer has wrapped
+	bool m_enabled;											/// < whether spans are recorded
+	std::chrono::steady_clock::time_point m_origin;			/// < time zero of the trace
+};
+
+} // namespace gui
@@ -1,6 +1,13 @@
 #include "Renderer.hpp"
 #include <iostream>
 
+// session written by F9 and replayed by F10
+static const std::string sessionFile = "session.gsr";
+static const std::string reportFile = "session_report.csv";
+
+// trace written by F11 and at exit
+static const std::string traceFile = "gui_trace.json";
+
 void Renderer::initWindow()
 {
 	sf::ContextSettings settings;
@@ -16,29 +23,52 @@ Renderer::Renderer()
 
 	running = true;
 	paused = false;
+	idleMode = true;
+	repaint = true;
+	replayPending = false;
+	replayRealTime = true;
 
 	font.loadFromFile("data/consola.ttf");
 
+#ifdef GUI_PROFILING
+	hud.reset(new gui::ProfilerOverlay(frame.getProfiler(), font));
+	hud->setPosition(10, 650);
+	showHud = true;
+#endif
+
 	
 
 	frame.setWindow(window);
 
+	// every input read by the frame goes through the recorder
+	recorder.setSource(*frame.getInputSource());
+	frame.setInputSource(recorder);
+
+	// every text button shares one style
+	gui::Style::Look normal, selection;
+	normal.fillColor = sf::Color::Transparent;
+	normal.outlineColor = sf::Color(160, 32, 240);
+	normal.outlineThickness = 3;
+	selection.fillColor = sf::Color(160, 32, 240, 126);
+	selection.outlineColor = sf::Color(124, 163, 251);
+	selection.outlineThickness = 5;
+	std::shared_ptr<const gui::Style> buttonStyle = std::make_shared<const gui::Style>(normal, selection);
+
 	button.setSize({ 80, 40 });
 	button.setPosition(20, 5);
-	button.setBoxFillColor(sf::Color::Transparent);
-	button.setBoxOutlineColor(sf::Color(160, 32, 240));
-	button.setBoxOutlineThickness(3);
-	button.setSelectionFillColor(sf::Color(160, 32, 240, 126));
-	button.setSelectionOutlineColor(sf::Color(124, 163, 251));
-	button.setSelectionOutlineThickness(5);
+	button.setButtonStyle(buttonStyle);
 	button.setCharacterSize(22);
 	button.setTextFillColor(sf::Color::White);
 	button.setFont(font);
 	button.setString("Button 1");
 
-	button2 = button;
-	button2.setString("button2");
+	button2.setSize({ 80, 40 });
 	button2.setPosition(120, 5);
+	button2.setButtonStyle(buttonStyle);
+	button2.setCharacterSize(22);
+	button2.setTextFillColor(sf::Color::White);
+	button2.setFont(font);
+	button2.setString("button2");
 
 	text.setSize({ 80, 40 });
 	text.setPosition(400, 5);
@@ -87,25 +117,15 @@ Renderer::Renderer()
 	drop.setPosition(20, 20);
 	drop.setFillColor(sf::Color(255, 255, 255, 26));
 
-	dbutton1.setBoxFillColor(sf::Color::Transparent);
-	dbutton1.setBoxOutlineColor(sf::Color(160, 32, 240));
-	dbutton1.setBoxOutlineThickness(3);
-	dbutton1.setSelectionFillColor(sf::Color(160, 32, 240, 126));
-	dbutton1.setSelectionOutlineColor(sf::Color(124, 163, 251));
-	dbutton1.setSelectionOutlineThickness(5);
-	dbutton1.setCharacterSize(22);
-	dbutton1.setTextFillColor(sf::Color::White);
-	dbutton1.setFont(font);
-	dbutton1.setString("dbutton1");
-	drop.addItem(dbutton1);
-
-	dbutton2 = dbutton1;
-	dbutton2.setString("dbutton2");
-	drop.addItem(dbutton2);
-
-	dbutton3 = dbutton1;
-	dbutton3.setString("dbutton3");
-	drop.addItem(dbutton3);
+	gui::TextButton* items[] = { &dbutton1, &dbutton2, &dbutton3 };
+	for (int i = 0; i < 3; i++) {
+		items[i]->setButtonStyle(buttonStyle);
+		items[i]->setCharacterSize(22);
+		items[i]->setTextFillColor(sf::Color::White);
+		items[i]->setFont(font);
+		items[i]->setString("dbutton" + std::to_string(i + 1));
+	}
+	drop.addItems({ &dbutton1, &dbutton2, &dbutton3 });
 
 	drop.setItemLimit(1);
 	drop.setTitle("Drop", font, 24, sf::Color::White);
@@ -155,6 +175,9 @@ Renderer::Renderer()
 
 Renderer::~Renderer()
 {
+#ifdef GUI_TRACING
+	if (gui::Tracer::get().saveToFile(traceFile, &frame))std::cout << "Trace written to " << traceFile << "\n";
+#endif
 }
 
 bool Renderer::isRunning()
@@ -166,6 +189,11 @@ void Renderer::update()
 {
 	this->pollEvents();
 
+	if (this->replayPending) {
+		this->replayPending = false;
+		this->replay(sessionFile, this->replayRealTime);
+	}
+
 	if (!this->paused) {
 		frame.update();
 	}
@@ -175,39 +203,142 @@ void Renderer::pollEvents()
 {
 	sf::Event event;
 
-	while (this->window.pollEvent(event))
-	{
-		if (event.type == sf::Event::Closed || event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape)
-			this->running = false;
-
-		if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Space)this->paused = !this->paused;
-
-		if (!this->paused) {
-			frame.pollEvents(event);
-			if (event.type == sf::Event::MouseMoved) {
-			}
-			else if (event.type == sf::Event::MouseButtonPressed) {
-				
-			}
-			else if (event.type == sf::Event::MouseButtonReleased) {
-				
-			}
-			else if (event.type == sf::Event::KeyPressed) {
-
-			}
+	// block until something happens if nothing can change on its own
+	if (this->idleMode && (this->paused || frame.isIdle()) && !this->repaint) {
+		if (this->window.waitEvent(event)) {
+			this->recorder.recordEvent(event);
+			this->handleEvent(event);
+		}
+	}
+
+	while (this->recorder.pollEvent(event))
+		this->handleEvent(event);
+}
+
+void Renderer::handleEvent(const sf::Event& event)
+{
+	if (event.type == sf::Event::Closed || (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Escape))
+		this->running = false;
+
+	if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Space)this->paused = !this->paused;
+
+	if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F2)this->setIdleMode(!this->idleMode);
+
+#ifdef GUI_PROFILING
+	if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+		this->showHud = !this->showHud;
+		this->repaint = true;
+	}
+#endif
+
+#ifdef GUI_TRACK_ALLOCATIONS
+	// allocations since the last report
+	if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4) {
+		gui::AllocationTracker::report(std::cout);
+		gui::AllocationTracker::reset();
+	}
+#endif
+
+#ifdef GUI_TRACING
+	if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F11) {
+		if (gui::Tracer::get().saveToFile(traceFile, &frame))std::cout << "Trace written to " << traceFile << "\n";
+	}
+#endif
+
+	if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F9) {
+		if (!this->recorder.isRecording()) {
+			this->recorder.start();
+			std::cout << "Recording input\n";
+		}
+		else {
+			this->recorder.stop();
+			if (this->recorder.saveToFile(sessionFile))
+				std::cout << "Recorded " << this->recorder.getFrames().size() << " frames to " << sessionFile << "\n";
+		}
+	}
+
+	// F10 replays in real time, shift + F10 as fast as possible
+	if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F10 && !this->recorder.isRecording()) {
+		this->replayPending = true;
+		this->replayRealTime = !event.key.shift;
+	}
+
+	// contents of the window may have been lost
+	if (event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus)this->repaint = true;
+
+	if (!this->paused) {
+		frame.pollEvents(event);
+		if (event.type == sf::Event::MouseMoved) {
+		}
+		else if (event.type == sf::Event::MouseButtonPressed) {
+			
+		}
+		else if (event.type == sf::Event::MouseButtonReleased) {
+			
+		}
+		else if (event.type == sf::Event::KeyPressed) {
+
 		}
 	}
 }
 
 void Renderer::render()
 {
+	// last presented image is still valid
+	if (this->idleMode && !this->repaint && !frame.hasPendingRedraw())return;
+	this->repaint = false;
+
 	this->window.clear();
 
 	frame.draw();
 
+#ifdef GUI_PROFILING
+	// overlay changes every frame, so the window is presented every frame
+	if (this->showHud) {
+		hud->update();
+		this->window.draw(*hud);
+		this->repaint = true;
+	}
+#endif
+
 	this->window.display();
 }
 
+void Renderer::setIdleMode(bool enable)
+{
+	this->idleMode = enable;
+	this->repaint = true;
+}
+
+void Renderer::replay(const std::string& filename, bool realTime)
+{
+	gui::InputReplay session;
+	if (!session.loadFromFile(filename)) {
+		std::cout << "Could not load " << filename << "\n";
+		return;
+	}
+
+	session.run(frame, realTime, [this] {
+		this->window.display();
+		this->window.clear();
+
+		// keep the window responsive, its events are not part of the session
+		sf::Event event;
+		while (this->window.pollEvent(event));
+	});
+	this->repaint = true;
+
+	const auto& timings = session.getTimings();
+	if (timings.empty())return;
+
+	const auto& slowest = timings[session.getSlowestFrame()];
+	std::cout << "Replayed " << timings.size() << " frames in " << session.getTotalTime().asMilliseconds() << " ms, "
+		<< "slowest frame " << session.getSlowestFrame() << " (dispatch " << slowest.dispatch.asMicroseconds()
+		<< " us, update " << slowest.update.asMicroseconds() << " us, draw " << slowest.draw.asMicroseconds() << " us)\n";
+
+	if (session.saveReport(reportFile))std::cout << "Frame timings written to " << reportFile << "\n";
+}
+
 sf::Vector2f Renderer::getMousePosition()
 {
 	return window.mapPixelToCoords(sf::Mouse::getPosition(this->window));
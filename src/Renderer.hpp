@@ -1,16 +1,28 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "GUI.hpp"
+#include "GUI/InputRecorder.hpp"
+#include "GUI/InputReplay.hpp"
+#include <memory>
 
 class Renderer {
 private:
 	sf::RenderWindow window;
 	bool running;
 	bool paused;
+	bool idleMode;		// wait for events and skip rendering while the frame is idle
+	bool repaint;		// window contents have to be presented again
+	bool replayPending;	// recorded session is replayed on next update
+	bool replayRealTime;	// replay waits for the recorded time of each frame
 
 
 	sf::Font font;
 	gui::Frame frame;
+	gui::InputRecorder recorder;
+#ifdef GUI_PROFILING
+	std::unique_ptr<gui::ProfilerOverlay> hud;
+	bool showHud;		// draw the profiler overlay above the frame
+#endif
 	float val;
 	gui::Button rectB;
 	gui::TextButton button, button2, button3, dbutton1, dbutton2, dbutton3, dbutton4, dbutton5, dbutton6;
@@ -20,6 +32,7 @@ private:
 	gui::Dropdown drop;
 
 	void initWindow();
+	void handleEvent(const sf::Event& event);
 public:
 	Renderer();
 	~Renderer();
@@ -30,6 +43,9 @@ public:
 	void pollEvents();
 	void render();
 
+	void setIdleMode(bool enable);
+	void replay(const std::string& filename, bool realTime);
+
 	sf::Vector2f getMousePosition();
 	sf::Vector2f getWinSize();
 };